@@ -33,6 +33,49 @@
 
 #include "Adafruit_MMC56x3.h"
 
+static_assert((MMC56X3_REMAP_X >= 0) && (MMC56X3_REMAP_X <= 2) &&
+                  (MMC56X3_REMAP_Y >= 0) && (MMC56X3_REMAP_Y <= 2) &&
+                  (MMC56X3_REMAP_Z >= 0) && (MMC56X3_REMAP_Z <= 2),
+              "MMC56X3_REMAP_X/Y/Z must each be MMC56X3_AXIS_X, _Y or _Z");
+static_assert((MMC56X3_REMAP_X != MMC56X3_REMAP_Y) &&
+                  (MMC56X3_REMAP_Y != MMC56X3_REMAP_Z) &&
+                  (MMC56X3_REMAP_X != MMC56X3_REMAP_Z),
+              "MMC56X3_REMAP_X/Y/Z must use each sensor axis exactly once");
+static_assert(((MMC56X3_REMAP_X_SIGN == 1) || (MMC56X3_REMAP_X_SIGN == -1)) &&
+                  ((MMC56X3_REMAP_Y_SIGN == 1) ||
+                   (MMC56X3_REMAP_Y_SIGN == -1)) &&
+                  ((MMC56X3_REMAP_Z_SIGN == 1) ||
+                   (MMC56X3_REMAP_Z_SIGN == -1)),
+              "MMC56X3_REMAP_*_SIGN must be 1 or -1");
+
+// the register map: each register's field masks add up to exactly the bits
+// the datasheet defines, which fails if any overlap or spill out of the byte
+static_assert(MMC56X3_OTP_READ_DONE.mask() + MMC56X3_SAT_SENSOR.mask() +
+                      MMC56X3_MEAS_M_DONE.mask() + MMC56X3_MEAS_T_DONE.mask() ==
+                  0xF0,
+              "MMC56X3 STATUS fields overlap");
+static_assert(MMC56X3_TAKE_MEAS_M.mask() + MMC56X3_TAKE_MEAS_T.mask() +
+                      MMC56X3_DO_SET.mask() + MMC56X3_DO_RESET.mask() +
+                      MMC56X3_AUTO_SR_EN.mask() + MMC56X3_AUTO_ST_EN.mask() +
+                      MMC56X3_CMM_FREQ_EN.mask() ==
+                  0xFB,
+              "MMC56X3 CTRL0 fields overlap");
+static_assert(MMC56X3_BW.mask() + MMC56X3_X_INHIBIT.mask() +
+                      MMC56X3_YZ_INHIBIT.mask() + MMC56X3_ST_ENP.mask() +
+                      MMC56X3_ST_ENM.mask() + MMC56X3_SW_RESET.mask() ==
+                  0xFF,
+              "MMC56X3 CTRL1 fields overlap");
+static_assert(MMC56X3_PRD_SET.mask() + MMC56X3_EN_PRD_SET.mask() +
+                      MMC56X3_CMM_EN.mask() + MMC56X3_HPOWER.mask() ==
+                  0x9F,
+              "MMC56X3 CTRL2 fields overlap");
+static_assert(MMC56X3_ODR.mask() == 0xFF, "MMC56X3 ODR field must fill it");
+static_assert((MMC56X3_ST_Y == MMC56X3_ST_X + 1) &&
+                  (MMC56X3_ST_Z == MMC56X3_ST_X + 2),
+              "selfTest() reads the three setpoints in one burst");
+static_assert(MMC56X3_STATUS_REG - MMC56X3_OUT_X_L < MMC56X3_BURST_LEN,
+              "A burst read must reach the STATUS register");
+
 /***************************************************************************
  MAGNETOMETER
  ***************************************************************************/
@@ -65,36 +108,53 @@ Adafruit_MMC5603::Adafruit_MMC5603(int32_t sensorID) {
  *            The I2C address to be used.
  *    @param  wire
  *            The Wire object to be used for I2C connections.
+ *    @param  i2c_speed
+ *            I2C clock to run at in Hz, e.g. MMC56X3_I2C_FAST, or 0 to
+ *            leave the bus as it is. See setBusSpeed().
  *    @return True if initialization was successful, otherwise false.
  */
-bool Adafruit_MMC5603::begin(uint8_t i2c_address, TwoWire *wire) {
+bool Adafruit_MMC5603::begin(uint8_t i2c_address, TwoWire *wire,
+                             uint32_t i2c_speed) {
   if (!i2c_dev) {
     i2c_dev = new Adafruit_I2CDevice(i2c_address, wire);
   }
+  _blocking.setDevice(i2c_dev);
+  if (!_transfer) {
+    _transfer = &_blocking;
+  }
 
   if (!i2c_dev->begin()) {
     return false;
   }
 
-  // Check connection
-  Adafruit_BusIO_Register chip_id =
-      Adafruit_BusIO_Register(i2c_dev, MMC56X3_PRODUCT_ID);
+  if (i2c_speed && !setBusSpeed(i2c_speed)) {
+    return false;
+  }
+
+  return begin(_transfer);
+}
 
-  // make sure we're talking to the right chip
-  uint8_t id = chip_id.read();
-  if ((id != MMC56X3_CHIP_ID) && (id != 0x0)) {
-    // No MMC56X3 detected ... return false
+/*!
+ *    @brief  Sets up the sensor over any transport, for buses other than
+ *            TwoWire. All register access goes through it.
+ *    @param  transport
+ *            The transport, already set up to reach the sensor.
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_MMC5603::begin(Adafruit_MMC56x3_Transfer *transport) {
+  if (!transport) {
     return false;
   }
+  _transfer = transport;
 
-  delete (_ctrl0_reg);
-  _ctrl0_reg = new Adafruit_BusIO_Register(i2c_dev, MMC56X3_CTRL0_REG);
-  delete (_ctrl1_reg);
-  _ctrl1_reg = new Adafruit_BusIO_Register(i2c_dev, MMC56X3_CTRL1_REG);
-  delete (_ctrl2_reg);
-  _ctrl2_reg = new Adafruit_BusIO_Register(i2c_dev, MMC56X3_CTRL2_REG);
-  delete (_status_reg);
-  _status_reg = new Adafruit_BusIO_Register(i2c_dev, MMC56X3_STATUS_REG);
+  // make sure we're talking to the right chip. Some parts read back 0,
+  // which only counts if the read itself succeeded.
+  uint8_t id;
+  if (!readRegisters(MMC56X3_PRODUCT_ID, &id, 1) ||
+      ((id != MMC56X3_CHIP_ID) && (id != 0x0))) {
+    // No MMC56X3 detected ... return false
+    return false;
+  }
 
   reset();
 
@@ -104,10 +164,11 @@ bool Adafruit_MMC5603::begin(uint8_t i2c_address, TwoWire *wire) {
  *    @brief  Resets the sensor to an initial state
  */
 void Adafruit_MMC5603::reset(void) {
-  _ctrl1_reg->write(0x80); // write only, set topmost bit
+  writeRegister(MMC56X3_CTRL1_REG, MMC56X3_SW_RESET.bits(1));
   delay(20);
   _odr_cache = 0;
   _ctrl2_cache = 0;
+  _cache_valid = false;
   magnetSetReset();
   setContinuousMode(false);
 }
@@ -116,12 +177,76 @@ void Adafruit_MMC5603::reset(void) {
  *    @brief  Pulse large currents through the sense coils to clear any offset
  */
 void Adafruit_MMC5603::magnetSetReset(void) {
-  _ctrl0_reg->write(0x08); // turn on set bit
+  writeRegister(MMC56X3_CTRL0_REG, MMC56X3_DO_SET.bits(1));
   delay(1);
-  _ctrl0_reg->write(0x10); // turn on reset bit
+  writeRegister(MMC56X3_CTRL0_REG, MMC56X3_DO_RESET.bits(1));
   delay(1);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Checks every axis using the on-chip self-test coils. Takes one
+    measurement with the positive coil current and one with the negative,
+    and compares each axis' difference against 80% of what the factory
+    setpoint predicts. Following MEMSIC's reference driver, the setpoint
+    registers are offset binary, (reg - 128) * 32 in 16-bit output counts
+    (16 raw counts each) for one coil polarity, so the positive minus
+    negative difference is twice that. Continuous mode is paused for the
+    test and then restored.
+    @param result Optional struct to fill with per-axis measurements
+    @returns True if all three axes pass, false if any fails or the sensor
+    could not be read
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::selfTest(mmc56x3_selftest_t *result) {
+  mmc56x3_selftest_t st;
+
+  // factory setpoints for x, y and z in a single burst
+  uint8_t setpoint[3];
+  if (!readRegisters(MMC56X3_ST_X_SETPOINT.reg, setpoint, 3)) {
+    return false;
+  }
+
+  _cache_valid = false; // nothing from before the test is served after
+  bool continuous = isContinuousMode();
+  if (continuous) {
+    setContinuousMode(false);
+  }
+
+  int32_t pos[3], neg[3];
+  bool ok = writeRegister(MMC56X3_CTRL1_REG, MMC56X3_ST_ENP.bits(1)) &&
+            measure(pos) &&
+            writeRegister(MMC56X3_CTRL1_REG, MMC56X3_ST_ENM.bits(1)) &&
+            measure(neg);
+  writeRegister(MMC56X3_CTRL1_REG, 0x00); // coils off
+
+  if (continuous) {
+    setContinuousMode(true);
+  }
+  if (!ok) {
+    return false;
+  }
+
+  // the remap is a signed permutation, so map setpoints the same way
+  static const uint8_t source[3] = {MMC56X3_REMAP_X, MMC56X3_REMAP_Y,
+                                    MMC56X3_REMAP_Z};
+  bool pass = true;
+  for (uint8_t i = 0; i < 3; i++) {
+    st.delta[i] = pos[i] - neg[i];
+    // (reg - 128) * 32 16-bit counts, * 16 to raw, * 2 for both polarities
+    int32_t response = ((int32_t)setpoint[source[i]] - 128) * 1024;
+    st.expected[i] = (response < 0) ? -response : response;
+    int32_t magnitude = (st.delta[i] < 0) ? -st.delta[i] : st.delta[i];
+    st.pass[i] = (st.expected[i] != 0) && (magnitude * 5 >= st.expected[i] * 4);
+    pass = pass && st.pass[i];
+  }
+
+  if (result) {
+    *result = st;
+  }
+  return pass;
+}
+
 /**************************************************************************/
 /*!
     @brief  Sets whether we are in continuous read mode (t) or one-shot (f)
@@ -129,13 +254,12 @@ void Adafruit_MMC5603::magnetSetReset(void) {
 */
 /**************************************************************************/
 void Adafruit_MMC5603::setContinuousMode(bool mode) {
+  _cache_valid = false;
   if (mode) {
-    _ctrl0_reg->write(0x80); // turn on cmm_freq_en bit
-    _ctrl2_cache |= 0x10;    // turn on cmm_en bit
-  } else {
-    _ctrl2_cache &= ~0x10; // turn off cmm_en bit
+    writeRegister(MMC56X3_CTRL0_REG, MMC56X3_CMM_FREQ_EN.bits(1));
   }
-  _ctrl2_reg->write(_ctrl2_cache);
+  _ctrl2_cache = MMC56X3_CMM_EN.set(_ctrl2_cache, mode);
+  writeRegister(MMC56X3_CTRL2_REG, _ctrl2_cache);
 }
 
 /**************************************************************************/
@@ -144,32 +268,42 @@ void Adafruit_MMC5603::setContinuousMode(bool mode) {
     @returns True for continuous, False for one-shot
 */
 /**************************************************************************/
-bool Adafruit_MMC5603::isContinuousMode(void) { return _ctrl2_cache & 0x10; }
+bool Adafruit_MMC5603::isContinuousMode(void) {
+  return MMC56X3_CMM_EN.get(_ctrl2_cache);
+}
 
 /**************************************************************************/
 /*!
     @brief Read the temperature from onboard sensor - must not be in continuous
    mode for this to function it seems
-    @returns Floating point temp in C, or NaN if sensor is in continuous mode
+    @returns Floating point temp in C, or NaN if sensor is in continuous mode,
+    a read fails or the conversion does not finish in twice the expected time
 */
 /**************************************************************************/
 float Adafruit_MMC5603::readTemperature(void) {
   if (isContinuousMode())
     return NAN;
 
-  _ctrl0_reg->write(0x02); // TM_T trigger
-
-  Adafruit_BusIO_RegisterBits temp_read_done =
-      Adafruit_BusIO_RegisterBits(_status_reg, 1, 7);
+  if (!writeRegister(MMC56X3_CTRL0_REG, MMC56X3_TAKE_MEAS_T.bits(1)))
+    return NAN;
 
-  while (!temp_read_done.read()) {
+  // give up at twice the expected time, as measure() does
+  uint32_t wait = getMeasurementTime();
+  uint32_t start = micros();
+  uint8_t status;
+  do {
+    if (micros() - start > 2 * wait + 1000)
+      return NAN;
     delay(5);
-  }
+    if (!readRegisters(MMC56X3_STATUS_REG, &status, 1))
+      return NAN;
+  } while (!MMC56X3_MEAS_T_DONE.get(status));
 
-  Adafruit_BusIO_Register temp_data =
-      Adafruit_BusIO_Register(i2c_dev, MMC56X3_OUT_TEMP);
+  uint8_t temp_data;
+  if (!readRegisters(MMC56X3_OUT_TEMP, &temp_data, 1))
+    return NAN;
 
-  float temp = temp_data.read();
+  float temp = temp_data;
   temp *= 0.8; //  0.8*C / LSB
   temp -= 75;  //  0 value is -75
 
@@ -178,51 +312,531 @@ float Adafruit_MMC5603::readTemperature(void) {
 
 /**************************************************************************/
 /*!
-    @brief  Gets the most recent sensor event
-    @param event The `sensors_event_t` to fill with event data
-    @returns true, always
+    @brief  Starts a one-shot magnetic measurement without waiting for it.
+    Does nothing in continuous mode.
+    @returns True if the trigger was written
 */
 /**************************************************************************/
-bool Adafruit_MMC5603::getEvent(sensors_event_t *event) {
+bool Adafruit_MMC5603::startMeasurement(void) {
+  if (isContinuousMode())
+    return true;
 
-  /* Clear the event */
-  memset(event, 0, sizeof(sensors_event_t));
+  return writeRegister(MMC56X3_CTRL0_REG, MMC56X3_TAKE_MEAS_M.bits(1));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Checks whether a one-shot magnetic measurement has finished,
+    with a single status register read. Always true in continuous mode.
+    @returns True if readMeasurement() will return fresh data
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::isDataReady(void) {
+  if (isContinuousMode())
+    return true;
+
+  uint8_t status;
+  if (!readRegisters(MMC56X3_STATUS_REG, &status, 1))
+    return false;
+  return MMC56X3_MEAS_M_DONE.get(status);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads consecutive registers through the transport
+    @param reg First register address
+    @param buffer Where the values go
+    @param len Number of registers
+    @returns True if the read succeeded, false without touching the bus
+    while a startDataRead() is still running
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::readRegisters(uint8_t reg, uint8_t *buffer,
+                                     uint8_t len) {
+  return _transfer && !isDataReadBusy() &&
+         _transfer->writeThenRead(&reg, 1, buffer, len);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Writes one register through the transport
+    @param reg Register address
+    @param value Value to write
+    @returns True if the write succeeded, false without touching the bus
+    while a startDataRead() is still running
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::writeRegister(uint8_t reg, uint8_t value) {
+  uint8_t buffer[2] = {reg, value};
+  return _transfer && !isDataReadBusy() && _transfer->write(buffer, 2);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Predicts how long a one-shot measurement takes to convert, so
+    non-blocking callers know when to start checking isDataReady()
+    @returns Conversion time in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC5603::getMeasurementTime(void) {
+  return 6600; // bandwidth setting 00, per datasheet
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the I2C clock, falling back to slower standard speeds if
+    the platform refuses it or the sensor stops answering. This changes
+    the clock for everything else on the same bus too.
+    @param hz Fastest clock to try, in Hz. The datasheet maximum is
+    MMC56X3_I2C_FAST, MMC56X3_I2C_FASTPLUS often works on short wiring.
+    @returns The clock now in use, which getTransferTime() assumes, or 0 if
+    the sensor did not answer even at the standard 100 kHz or a
+    startDataRead() is still running
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC5603::setBusSpeed(uint32_t hz) {
+  if (!i2c_dev || isDataReadBusy()) {
+    return 0; // not on I2C, or mid-transfer
+  }
+  static const uint32_t steps[] = {MMC56X3_I2C_FASTPLUS, MMC56X3_I2C_FAST,
+                                   MMC56X3_I2C_STANDARD};
+  uint8_t step = 0;
+
+  for (;;) {
+    if (hz && i2c_dev->setSpeed(hz)) {
+      uint8_t id = 0xFF;
+      if (readRegisters(MMC56X3_PRODUCT_ID, &id, 1) &&
+          ((id == MMC56X3_CHIP_ID) || (id == 0x0))) {
+        _bus_speed = hz;
+        return hz;
+      }
+    }
+    while ((step < sizeof(steps) / sizeof(steps[0])) && (steps[step] >= hz))
+      step++;
+    if (step == sizeof(steps) / sizeof(steps[0])) {
+      return 0;
+    }
+    hz = steps[step];
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Predicts how long a write-then-read takes on the wire at the
+    current bus speed, ignoring clock stretching and software overhead
+    @param write_len Bytes written, including the register address
+    @param read_len Bytes read, or 0 for a plain write
+    @returns Transfer time in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC5603::getTransferTime(uint8_t write_len,
+                                           uint8_t read_len) {
+  // 9 clocks per byte with its ack, plus the address byte of each phase,
+  // start, repeated start and stop
+  uint32_t bits = 9 * (1 + write_len) + 2;
+  if (read_len) {
+    bits += 9 * (1 + read_len) + 1;
+  }
+  return (bits * 1000000UL + _bus_speed - 1) / _bus_speed;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Predicts the time for one sample as readRaw() takes it: in
+    one-shot mode the trigger, conversion and the ready check and data
+    read, in continuous mode just the data read
+    @returns Sample time in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC5603::getSampleTime(void) {
+  uint32_t t = getReadCost(_read_strategy);
+  if (!isContinuousMode()) {
+    t += _transaction_overhead + getTransferTime(2, 0) + getMeasurementTime();
+  }
+  return t;
+}
 
-  /* Read new data */
+/**************************************************************************/
+/*!
+    @brief  Predicts the bus time to find out whether data is ready and
+    fetch it, assuming the first check finds it ready, which readRaw()
+    arranges in one-shot mode by waiting out the conversion before it
+    checks. Both strategies check with their own status read in one-shot
+    mode and skip it in continuous mode; they differ only in how many
+    bytes the data read moves, so MMC56X3_READ_AUTO picks separate reads.
+    @param strategy The strategy to cost, MMC56X3_READ_AUTO gives the
+    cheaper of the two
+    @returns Time in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC5603::getReadCost(mmc56x3_read_strategy_t strategy) {
+  uint32_t check = 0;
   if (!isContinuousMode()) {
-    _ctrl0_reg->write(0x01); // TM_M trigger
+    check = _transaction_overhead + getTransferTime(1, 1);
+  }
+  uint32_t burst = check + _transaction_overhead +
+                   getTransferTime(1, MMC56X3_BURST_LEN);
+  uint32_t separate = check + _transaction_overhead + getTransferTime(1, 9);
+
+  switch (strategy) {
+  case MMC56X3_READ_BURST:
+    return burst;
+  case MMC56X3_READ_SEPARATE:
+    return separate;
+  default:
+    return (burst < separate) ? burst : separate;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads the data, temperature and status registers (0x00-0x18)
+    in one transaction. The status byte is read last, after the data
+    registers, and reading those may already have cleared Meas_m_done, so
+    it does not say whether raw is new: check isDataReady() first.
+    @param raw Array of 3 to fill with the x, y and z counts, at
+    MMC56X3_LSB_UT uTesla per count
+    @param status Filled with the STATUS register if not NULL
+    @returns True if the read succeeded
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::readBurst(int32_t raw[3], uint8_t *status) {
+  uint8_t buffer[MMC56X3_BURST_LEN];
+  if (!readRegisters(MMC56X3_OUT_X_L, buffer, MMC56X3_BURST_LEN))
+    return false;
+
+  unpack(buffer, raw);
+  _last_status = buffer[MMC56X3_STATUS_REG - MMC56X3_OUT_X_L];
+  if (status)
+    *status = _last_status;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads the most recent magnetic data as signed raw counts, centered
+    on zero. In one-shot mode a new measurement is triggered first and
+    waited for, then read as set by setReadStrategy(). With a window set
+    by setMaxAge(), a sample younger than that is returned again without
+    touching the bus.
+    @param raw Array of 3 to fill with the x, y and z counts, at
+    MMC56X3_LSB_UT uTesla per count
+    @returns True if the data was read, false on a bus error or if the
+    measurement did not finish in twice the expected time
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::readRaw(int32_t raw[3]) {
+  if (_max_age) {
+    if (_cache_valid && (micros() - _cache.timestamp < _max_age)) {
+      memcpy(raw, _cache.raw, sizeof(_cache.raw));
+      _cache_hits++;
+      return true;
+    }
+    _cache_misses++;
+  }
+
+  if (!measure(raw)) {
+    return false;
+  }
+  cacheSample(raw);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Keeps a sample as the latest one, for readRaw() to serve
+    within the cache window and getEvent() to timestamp
+    @param raw The x, y and z raw counts
+*/
+/**************************************************************************/
+void Adafruit_MMC5603::cacheSample(const int32_t raw[3]) {
+  memcpy(_cache.raw, raw, sizeof(_cache.raw));
+  _cache.timestamp = micros();
+  _cache_millis = millis();
+  _cache_valid = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets a new sample from the sensor, as readRaw() does without
+    the cache
+    @param raw Array of 3 to fill with the x, y and z counts
+    @returns True if the data was read
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::measure(int32_t raw[3]) {
+
+  mmc56x3_read_strategy_t strategy = _read_strategy;
+  if (strategy == MMC56X3_READ_AUTO) {
+    strategy = (getReadCost(MMC56X3_READ_BURST) <
+                getReadCost(MMC56X3_READ_SEPARATE))
+                   ? MMC56X3_READ_BURST
+                   : MMC56X3_READ_SEPARATE;
+  }
 
-    Adafruit_BusIO_RegisterBits mag_read_done =
-        Adafruit_BusIO_RegisterBits(_status_reg, 1, 6);
-    while (!mag_read_done.read()) {
-      delay(5);
+  if (!isContinuousMode()) {
+    // wait out the conversion, so the first check normally finds it done
+    // as getReadCost() assumes, and give up at twice the expected time
+    if (!startMeasurement())
+      return false;
+    uint32_t wait = getMeasurementTime();
+    delayMicroseconds(wait);
+    uint32_t start = micros();
+    while (!isDataReady()) {
+      if (micros() - start > 2 * wait + 1000)
+        return false;
+      delay(1);
     }
   }
+
+  // freshness comes from the status read above, not the status byte of a
+  // burst, which may have been cleared by the data read ahead of it
+  if (strategy == MMC56X3_READ_BURST)
+    return readBurst(raw);
+  return readMeasurement(raw);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads and unpacks the output registers without triggering or
+    waiting, the last step of a non-blocking measurement
+    @param raw Array of 3 to fill with the x, y and z counts, at
+    MMC56X3_LSB_UT uTesla per count
+    @returns True if the data was read
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::readMeasurement(int32_t raw[3]) {
   uint8_t buffer[9];
-  buffer[0] = MMC56X3_OUT_X_L;
-
-  // read 8 bytes!
-  i2c_dev->write_then_read(buffer, 1, buffer, 9);
-
-  x = (uint32_t)buffer[0] << 12 | (uint32_t)buffer[1] << 4 |
-      (uint32_t)buffer[6] >> 4;
-  y = (uint32_t)buffer[2] << 12 | (uint32_t)buffer[3] << 4 |
-      (uint32_t)buffer[7] >> 4;
-  z = (uint32_t)buffer[4] << 12 | (uint32_t)buffer[5] << 4 |
-      (uint32_t)buffer[8] >> 4;
-  // fix center offsets
-  x -= (uint32_t)1 << 19;
-  y -= (uint32_t)1 << 19;
-  z -= (uint32_t)1 << 19;
 
+  // read 9 bytes!
+  if (!readRegisters(MMC56X3_OUT_X_L, buffer, 9))
+    return false;
+
+  unpack(buffer, raw);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Unpacks the 9 output register bytes into centered, remapped
+    20-bit counts and keeps them as the latest reading
+    @param buffer Registers 0x00 to 0x08
+    @param raw Array of 3 to fill with the x, y and z counts
+*/
+/**************************************************************************/
+void Adafruit_MMC5603::unpack(const uint8_t buffer[9], int32_t raw[3]) {
+  int32_t sensor[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    sensor[i] = (uint32_t)buffer[2 * i] << 12 |
+                (uint32_t)buffer[2 * i + 1] << 4 | (uint32_t)buffer[6 + i] >> 4;
+    // fix center offsets
+    sensor[i] -= (uint32_t)1 << 19;
+  }
+
+  // mounting orientation, the indices and signs are compile time constants
+  // so this folds down to plain moves
+  x = MMC56X3_REMAP_X_SIGN * sensor[MMC56X3_REMAP_X];
+  y = MMC56X3_REMAP_Y_SIGN * sensor[MMC56X3_REMAP_Y];
+  z = MMC56X3_REMAP_Z_SIGN * sensor[MMC56X3_REMAP_Z];
+
+  raw[0] = x;
+  raw[1] = y;
+  raw[2] = z;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the transport used for all register access, e.g. a DMA
+    backed one so the CPU is free while startDataRead() runs
+    @param transfer The transport, or NULL for the blocking I2C default
+*/
+/**************************************************************************/
+void Adafruit_MMC5603::setTransfer(Adafruit_MMC56x3_Transfer *transfer) {
+  _transfer = transfer ? transfer : &_blocking;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Starts reading the output registers in the background, the
+    asynchronous form of readMeasurement(). With the default blocking
+    transfer the read is complete when this returns. Until it finishes
+    the transport belongs to the read: other register accesses are
+    refused rather than interleaved with it, and calls that report
+    success return false.
+    @param callback Called when the read finishes, possibly from interrupt
+    context, or NULL to poll isDataReadBusy()
+    @param context Passed to the callback
+    @returns False if a read is already running or could not start
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::startDataRead(mmc56x3_transfer_callback_t callback,
+                                     void *context) {
+  if (!_transfer || (_read_pending && _transfer->isBusy())) {
+    return false;
+  }
+  static const uint8_t reg = MMC56X3_OUT_X_L;
+  _read_pending = true;
+  if (!_transfer->startWriteThenRead(&reg, 1, _read_buffer, 9, callback,
+                                     context)) {
+    _read_pending = false;
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Checks on a read started by startDataRead()
+    @returns True while the transfer is still running
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::isDataReadBusy(void) {
+  return _read_pending && _transfer->isBusy();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Unpacks the data from a finished startDataRead()
+    @param raw Array of 3 to fill with the x, y and z counts, at
+    MMC56X3_LSB_UT uTesla per count
+    @returns False if no read was started, it is still running or it failed
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::finishDataRead(int32_t raw[3]) {
+  if (!_read_pending || _transfer->isBusy()) {
+    return false;
+  }
+  _read_pending = false;
+  if (!_transfer->getStatus()) {
+    return false;
+  }
+  unpack(_read_buffer, raw);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the most recent sensor event, from the cache if it is
+    fresh enough (see setMaxAge()), timestamped when it was measured
+    @param event The `sensors_event_t` to fill with event data
+    @returns True if the data was read, false leaving the event cleared
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::getEvent(sensors_event_t *event) {
+
+  /* Clear the event */
+  memset(event, 0, sizeof(sensors_event_t));
+
+  int32_t raw[3];
+  if (!readRaw(raw))
+    return false;
+  rawToEvent(raw, event, _cache_millis);
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fills in a sensor event from raw counts
+    @param raw The x, y and z raw counts
+    @param event The event to fill, already cleared
+    @param timestamp millis() when the sample was read
+*/
+/**************************************************************************/
+void Adafruit_MMC5603::rawToEvent(const int32_t raw[3], sensors_event_t *event,
+                                  uint32_t timestamp) {
   event->version = sizeof(sensors_event_t);
   event->sensor_id = _sensorID;
   event->type = SENSOR_TYPE_MAGNETIC_FIELD;
-  event->timestamp = millis();
-  event->magnetic.x = (float)x * 0.00625; // scale to uT by LSB in datasheet
-  event->magnetic.y = (float)y * 0.00625;
-  event->magnetic.z = (float)z * 0.00625;
+  event->timestamp = timestamp;
+  event->magnetic.x = (float)raw[0] * MMC56X3_LSB_UT; // scale to uT by LSB
+  event->magnetic.y = (float)raw[1] * MMC56X3_LSB_UT;
+  event->magnetic.z = (float)raw[2] * MMC56X3_LSB_UT;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets a function for service() to call with each new sample in
+    raw counts
+    @param callback The function, or NULL to remove it
+    @param context Passed to the callback
+*/
+/**************************************************************************/
+void Adafruit_MMC5603::setRawCallback(mmc56x3_raw_callback_t callback,
+                                      void *context) {
+  _raw_callback = callback;
+  _raw_context = context;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets a function for service() to call with each new sample as
+    a sensor event in uTesla
+    @param callback The function, or NULL to remove it
+    @param context Passed to the callback
+*/
+/**************************************************************************/
+void Adafruit_MMC5603::setEventCallback(mmc56x3_event_callback_t callback,
+                                        void *context) {
+  _event_callback = callback;
+  _event_context = context;
+}
 
+/**************************************************************************/
+/*!
+    @brief  Delivers new samples to the callbacks without blocking. Call it
+    often, from loop() or a periodic timer. It only touches the bus when
+    a sample is due: in one-shot mode it triggers a measurement, waits out
+    the predicted conversion time, checks status and then reads; in
+    continuous mode it reads once per output period. Nothing is allocated,
+    so it may run in interrupt context on cores whose Wire works there.
+    Its samples also refresh the cache that readRaw() serves from.
+    @returns True if a sample was delivered
+*/
+/**************************************************************************/
+bool Adafruit_MMC5603::service(void) {
+  if (!_raw_callback && !_event_callback) {
+    return false;
+  }
+  uint32_t now = micros();
+  if ((int32_t)(now - _service_due) < 0) {
+    return false;
+  }
+
+  if (!isContinuousMode()) {
+    if (!_converting) {
+      _converting = startMeasurement();
+      _service_due = now + getMeasurementTime();
+      return false;
+    }
+    if (!isDataReady()) {
+      _service_due = now + 500;
+      return false;
+    }
+    _converting = false;
+  } else {
+    uint32_t period =
+        _odr_cache ? (1000000UL / _odr_cache) : getMeasurementTime();
+    _service_due += period;
+    if ((int32_t)(now - _service_due) >= 0) {
+      _service_due = now + period; // fell behind, don't try to catch up
+    }
+  }
+
+  int32_t raw[3];
+  if (!readMeasurement(raw)) {
+    return false;
+  }
+  cacheSample(raw);
+  if (_raw_callback) {
+    _raw_callback(raw, _raw_context);
+  }
+  if (_event_callback) {
+    sensors_event_t event;
+    memset(&event, 0, sizeof(sensors_event_t));
+    rawToEvent(raw, &event, _cache_millis);
+    _event_callback(&event, _event_context);
+  }
   return true;
 }
 
@@ -237,19 +851,12 @@ void Adafruit_MMC5603::setDataRate(uint16_t rate) {
   if (rate > 255)
     rate = 1000;
   _odr_cache = rate;
+  _cache_valid = false;
 
-  Adafruit_BusIO_Register odr_reg =
-      Adafruit_BusIO_Register(i2c_dev, MMC5603_ODR_REG);
-
-  if (rate == 1000) {
-    odr_reg.write(255);
-    _ctrl2_cache |= 0x80; // turn on hpower bit
-    _ctrl2_reg->write(_ctrl2_cache);
-  } else {
-    odr_reg.write(rate);
-    _ctrl2_cache &= ~0x80; // turn off hpower bit
-    _ctrl2_reg->write(_ctrl2_cache);
-  }
+  // 1000 Hz is the top ODR setting with high power mode on
+  writeRegister(MMC5603_ODR_REG, MMC56X3_ODR.bits(rate == 1000 ? 255 : rate));
+  _ctrl2_cache = MMC56X3_HPOWER.set(_ctrl2_cache, rate == 1000);
+  writeRegister(MMC56X3_CTRL2_REG, _ctrl2_cache);
 }
 
 /**************************************************************************/
@@ -258,7 +865,7 @@ void Adafruit_MMC5603::setDataRate(uint16_t rate) {
     @returns The current data rate from 0-255 or 1000
 */
 /**************************************************************************/
-uint16_t Adafruit_MMC5603::getDataRate(void) { return _ctrl2_cache; }
+uint16_t Adafruit_MMC5603::getDataRate(void) { return _odr_cache; }
 
 /**************************************************************************/
 /*!
@@ -19,20 +19,63 @@
 #ifndef MMC56X3_MAG_H
 #define MMC56X3_MAG_H
 
-#include <Adafruit_BusIO_Register.h>
-
 #include <Adafruit_I2CDevice.h>
 #include <Adafruit_Sensor.h>
 #include <Wire.h>
 
+#include "Adafruit_MMC56x3_Transfer.h"
+
 /*=========================================================================
     I2C ADDRESS/BITS
     -----------------------------------------------------------------------*/
 #define MMC56X3_DEFAULT_ADDRESS 0x30 //!< Default address
 #define MMC56X3_CHIP_ID 0x10         //!< Chip ID from WHO_AM_I register
+#define MMC56X3_LSB_UT 0.00625f      //!< uTesla per LSB of 20-bit output
+#define MMC56X3_I2C_STANDARD 100000  //!< Standard mode I2C clock, Hz
+#define MMC56X3_I2C_FAST 400000      //!< Fast mode, datasheet maximum, Hz
+#define MMC56X3_I2C_FASTPLUS 1000000 //!< Fast mode plus, beyond spec, Hz
+#define MMC56X3_BURST_LEN 25         //!< Registers 0x00-0x18 incl. status
+#ifndef MMC56X3_TRANSACTION_OVERHEAD_US
+#define MMC56X3_TRANSACTION_OVERHEAD_US 40 //!< Default software cost, us
+#endif
 
 /*=========================================================================*/
 
+/*=========================================================================
+    MOUNTING ORIENTATION
+    -----------------------------------------------------------------------
+    Selects which sensor axis, and with what sign, is reported as each of
+    x, y and z. It is applied when raw data is unpacked, so readRaw(),
+    getEvent() and everything built on them see the remapped axes. Set
+    these as build flags (e.g. -DMMC56X3_REMAP_X=MMC56X3_AXIS_Y in
+    platformio.ini) since the library is compiled separately from sketches.
+    Keep an even number of negations plus swaps for a proper rotation, an
+    odd number mirrors the frame and flips heading direction.
+    -----------------------------------------------------------------------*/
+#define MMC56X3_AXIS_X 0 //!< Sensor x axis
+#define MMC56X3_AXIS_Y 1 //!< Sensor y axis
+#define MMC56X3_AXIS_Z 2 //!< Sensor z axis
+
+#ifndef MMC56X3_REMAP_X
+#define MMC56X3_REMAP_X MMC56X3_AXIS_X //!< Sensor axis reported as x
+#endif
+#ifndef MMC56X3_REMAP_Y
+#define MMC56X3_REMAP_Y MMC56X3_AXIS_Y //!< Sensor axis reported as y
+#endif
+#ifndef MMC56X3_REMAP_Z
+#define MMC56X3_REMAP_Z MMC56X3_AXIS_Z //!< Sensor axis reported as z
+#endif
+#ifndef MMC56X3_REMAP_X_SIGN
+#define MMC56X3_REMAP_X_SIGN 1 //!< 1 or -1, sign of the reported x
+#endif
+#ifndef MMC56X3_REMAP_Y_SIGN
+#define MMC56X3_REMAP_Y_SIGN 1 //!< 1 or -1, sign of the reported y
+#endif
+#ifndef MMC56X3_REMAP_Z_SIGN
+#define MMC56X3_REMAP_Z_SIGN 1 //!< 1 or -1, sign of the reported z
+#endif
+/*=========================================================================*/
+
 /*!
  * @brief MMC56X3 I2C register address bits
  */
@@ -45,10 +88,154 @@ typedef enum {
   MMC56X3_OUT_TEMP = 0x09,
   MMC56X3_OUT_X_L = 0x00,
   MMC5603_ODR_REG = 0x1A,
+  MMC56X3_ST_X_TH = 0x1E,
+  MMC56X3_ST_Y_TH = 0x1F,
+  MMC56X3_ST_Z_TH = 0x20,
+  MMC56X3_ST_X = 0x27,
+  MMC56X3_ST_Y = 0x28,
+  MMC56X3_ST_Z = 0x29,
 
 } mmc56x3_register_t;
 /*=========================================================================*/
 
+/*!
+ * @brief A bit field within one register. All members are constexpr, so
+ * with a constant descriptor the accessors fold down to a mask and shift
+ * of a byte that was already read or cached.
+ */
+struct mmc56x3_field_t {
+  uint8_t reg;   ///< Register address
+  uint8_t shift; ///< Position of the lowest bit
+  uint8_t width; ///< Number of bits
+
+  /*! @brief Register bits the field occupies @returns Mask */
+  constexpr uint8_t mask() const {
+    return (uint8_t)(((1u << width) - 1) << shift);
+  }
+  /*! @brief Extracts the field from a register value
+      @param value Register byte @returns Field value */
+  constexpr uint8_t get(uint8_t value) const {
+    return (uint8_t)((value & mask()) >> shift);
+  }
+  /*! @brief Moves a field value into place, for writes that build a
+      register from several fields
+      @param field Field value @returns Register bits */
+  constexpr uint8_t bits(uint8_t field) const {
+    return (uint8_t)((field << shift) & mask());
+  }
+  /*! @brief Replaces the field in a register value, leaving other bits
+      @param value Register byte @param field New field value
+      @returns Updated register byte */
+  constexpr uint8_t set(uint8_t value, uint8_t field) const {
+    return (uint8_t)((value & ~mask()) | bits(field));
+  }
+};
+
+/*=========================================================================
+    REGISTER FIELDS
+    -----------------------------------------------------------------------
+    CTRL0 and CTRL1 are write only and their command bits clear
+    themselves, CTRL2 is kept in a cache and always written whole.
+    -----------------------------------------------------------------------*/
+//! Factory trim loaded after power up or reset
+constexpr mmc56x3_field_t MMC56X3_OTP_READ_DONE = {MMC56X3_STATUS_REG, 4, 1};
+//! Self-test signal saturated the sensor
+constexpr mmc56x3_field_t MMC56X3_SAT_SENSOR = {MMC56X3_STATUS_REG, 5, 1};
+//! Magnetic measurement finished
+constexpr mmc56x3_field_t MMC56X3_MEAS_M_DONE = {MMC56X3_STATUS_REG, 6, 1};
+//! Temperature measurement finished
+constexpr mmc56x3_field_t MMC56X3_MEAS_T_DONE = {MMC56X3_STATUS_REG, 7, 1};
+
+//! Start a one-shot magnetic measurement
+constexpr mmc56x3_field_t MMC56X3_TAKE_MEAS_M = {MMC56X3_CTRL0_REG, 0, 1};
+//! Start a temperature measurement
+constexpr mmc56x3_field_t MMC56X3_TAKE_MEAS_T = {MMC56X3_CTRL0_REG, 1, 1};
+//! Pulse the set current through the coils
+constexpr mmc56x3_field_t MMC56X3_DO_SET = {MMC56X3_CTRL0_REG, 3, 1};
+//! Pulse the reset current through the coils
+constexpr mmc56x3_field_t MMC56X3_DO_RESET = {MMC56X3_CTRL0_REG, 4, 1};
+//! Set/reset automatically before measurements
+constexpr mmc56x3_field_t MMC56X3_AUTO_SR_EN = {MMC56X3_CTRL0_REG, 5, 1};
+//! Check against the self-test thresholds
+constexpr mmc56x3_field_t MMC56X3_AUTO_ST_EN = {MMC56X3_CTRL0_REG, 6, 1};
+//! Recalculate the continuous mode period from ODR
+constexpr mmc56x3_field_t MMC56X3_CMM_FREQ_EN = {MMC56X3_CTRL0_REG, 7, 1};
+
+//! Bandwidth, sets measurement time and noise
+constexpr mmc56x3_field_t MMC56X3_BW = {MMC56X3_CTRL1_REG, 0, 2};
+//! Skip the x channel
+constexpr mmc56x3_field_t MMC56X3_X_INHIBIT = {MMC56X3_CTRL1_REG, 2, 1};
+//! Skip the y and z channels, both bits set together
+constexpr mmc56x3_field_t MMC56X3_YZ_INHIBIT = {MMC56X3_CTRL1_REG, 3, 2};
+//! Positive self-test coil current
+constexpr mmc56x3_field_t MMC56X3_ST_ENP = {MMC56X3_CTRL1_REG, 5, 1};
+//! Negative self-test coil current
+constexpr mmc56x3_field_t MMC56X3_ST_ENM = {MMC56X3_CTRL1_REG, 6, 1};
+//! Software reset, reloads the factory trim
+constexpr mmc56x3_field_t MMC56X3_SW_RESET = {MMC56X3_CTRL1_REG, 7, 1};
+
+//! Measurements between automatic set pulses, 1 to 2000 in 8 steps
+constexpr mmc56x3_field_t MMC56X3_PRD_SET = {MMC56X3_CTRL2_REG, 0, 3};
+//! Enable the periodic set pulse
+constexpr mmc56x3_field_t MMC56X3_EN_PRD_SET = {MMC56X3_CTRL2_REG, 3, 1};
+//! Continuous measurement mode
+constexpr mmc56x3_field_t MMC56X3_CMM_EN = {MMC56X3_CTRL2_REG, 4, 1};
+//! High power mode, required for the 1000 Hz rate
+constexpr mmc56x3_field_t MMC56X3_HPOWER = {MMC56X3_CTRL2_REG, 7, 1};
+
+//! Continuous mode output data rate
+constexpr mmc56x3_field_t MMC56X3_ODR = {MMC5603_ODR_REG, 0, 8};
+//! Automatic self-test threshold, x axis
+constexpr mmc56x3_field_t MMC56X3_ST_X_THRESHOLD = {MMC56X3_ST_X_TH, 0, 8};
+//! Automatic self-test threshold, y axis
+constexpr mmc56x3_field_t MMC56X3_ST_Y_THRESHOLD = {MMC56X3_ST_Y_TH, 0, 8};
+//! Automatic self-test threshold, z axis
+constexpr mmc56x3_field_t MMC56X3_ST_Z_THRESHOLD = {MMC56X3_ST_Z_TH, 0, 8};
+//! Factory self-test response, x axis, 16-bit counts
+constexpr mmc56x3_field_t MMC56X3_ST_X_SETPOINT = {MMC56X3_ST_X, 0, 8};
+//! Factory self-test response, y axis, 16-bit counts
+constexpr mmc56x3_field_t MMC56X3_ST_Y_SETPOINT = {MMC56X3_ST_Y, 0, 8};
+//! Factory self-test response, z axis, 16-bit counts
+constexpr mmc56x3_field_t MMC56X3_ST_Z_SETPOINT = {MMC56X3_ST_Z, 0, 8};
+/*=========================================================================*/
+
+/*!
+ * @brief How readRaw() checks for and fetches new data
+ */
+typedef enum {
+  MMC56X3_READ_SEPARATE, ///< status read(s), then the 9 data registers
+  MMC56X3_READ_BURST,    ///< status read(s), then 0x00-0x18 in one read
+  MMC56X3_READ_AUTO,     ///< whichever the cost model predicts is faster
+} mmc56x3_read_strategy_t;
+
+/*!
+ * @brief One timestamped raw magnetometer sample
+ */
+typedef struct {
+  int32_t raw[3];     ///< x, y and z raw counts, MMC56X3_LSB_UT uT each
+  uint32_t timestamp; ///< micros() when the sample was read
+} mmc56x3_sample_t;
+
+/*!
+ * @brief Per-axis results of selfTest(), in reported (remapped) axis order
+ */
+typedef struct {
+  int32_t delta[3];    ///< Positive minus negative coil reading, raw counts
+  int32_t expected[3]; ///< Difference the factory setpoint predicts
+  bool pass[3];        ///< True if the axis responded strongly enough
+} mmc56x3_selftest_t;
+
+/*!
+ * @brief Called by service() with each new sample, in raw counts
+ */
+typedef void (*mmc56x3_raw_callback_t)(const int32_t raw[3], void *context);
+
+/*!
+ * @brief Called by service() with each new sample, converted to uTesla
+ */
+typedef void (*mmc56x3_event_callback_t)(sensors_event_t *event,
+                                         void *context);
+
 /**************************************************************************/
 /*!
     @brief  Unified sensor driver for the magnetometer
@@ -58,13 +245,74 @@ class Adafruit_MMC5603 : public Adafruit_Sensor {
 public:
   Adafruit_MMC5603(int32_t sensorID = -1);
 
-  bool begin(uint8_t i2c_addr = MMC56X3_DEFAULT_ADDRESS, TwoWire *wire = &Wire);
+  bool begin(uint8_t i2c_addr = MMC56X3_DEFAULT_ADDRESS, TwoWire *wire = &Wire,
+             uint32_t i2c_speed = 0);
+  bool begin(Adafruit_MMC56x3_Transfer *transport);
 
   bool getEvent(sensors_event_t *);
+  bool readRaw(int32_t raw[3]);
+
+  /*! @brief Sets how old a sample readRaw() and getEvent() may return
+      instead of measuring again. Changing the mode or data rate, reset()
+      and selfTest() drop the cached sample.
+      @param us Maximum age in microseconds, 0 to always measure */
+  void setMaxAge(uint32_t us) { _max_age = us; }
+  /*! @brief Gets the sample cache window @returns Maximum age, us */
+  uint32_t getMaxAge(void) { return _max_age; }
+  /*! @brief Reads served from the cache @returns Hit count */
+  uint32_t getCacheHits(void) { return _cache_hits; }
+  /*! @brief Reads that went to the sensor with the cache enabled
+      @returns Miss count */
+  uint32_t getCacheMisses(void) { return _cache_misses; }
+  /*! @brief Zeroes the hit and miss counts */
+  void resetCacheStats(void) { _cache_hits = _cache_misses = 0; }
+
+  bool startMeasurement(void);
+  bool isDataReady(void);
+  bool readMeasurement(int32_t raw[3]);
+  uint32_t getMeasurementTime(void);
+  uint32_t setBusSpeed(uint32_t hz);
+  /*! @brief The I2C clock the timing model assumes
+      @returns Clock in Hz */
+  uint32_t getBusSpeed(void) { return _bus_speed; }
+  uint32_t getTransferTime(uint8_t write_len, uint8_t read_len);
+  uint32_t getSampleTime(void);
+
+  bool readBurst(int32_t raw[3], uint8_t *status = NULL);
+  /*! @brief Sets how readRaw() checks for and fetches data
+      @param strategy The read strategy */
+  void setReadStrategy(mmc56x3_read_strategy_t strategy) {
+    _read_strategy = strategy;
+  }
+  /*! @brief Gets how readRaw() checks for and fetches data
+      @returns The read strategy */
+  mmc56x3_read_strategy_t getReadStrategy(void) { return _read_strategy; }
+  /*! @brief Sets the fixed software time per bus transaction that the
+      cost model adds to the time on the wire
+      @param us Overhead in microseconds, measure it with the bus_speed
+      example */
+  void setTransactionOverhead(uint16_t us) { _transaction_overhead = us; }
+  uint32_t getReadCost(mmc56x3_read_strategy_t strategy);
+  /*! @brief STATUS register from the last burst read. Meas_m_done may
+      already be cleared by the data read ahead of it. @returns Status
+      byte */
+  uint8_t getLastStatus(void) { return _last_status; }
+
+  void setTransfer(Adafruit_MMC56x3_Transfer *transfer);
+  bool startDataRead(mmc56x3_transfer_callback_t callback = NULL,
+                     void *context = NULL);
+  bool isDataReadBusy(void);
+  bool finishDataRead(int32_t raw[3]);
   void getSensor(sensor_t *);
 
+  void setRawCallback(mmc56x3_raw_callback_t callback, void *context = NULL);
+  void setEventCallback(mmc56x3_event_callback_t callback,
+                        void *context = NULL);
+  bool service(void);
+
   void reset(void);
   void magnetSetReset(void);
+  bool selfTest(mmc56x3_selftest_t *result = NULL);
 
   void setContinuousMode(bool mode);
   bool isContinuousMode(void);
@@ -75,10 +323,19 @@ public:
   void setDataRate(uint16_t rate);
 
 private:
-  Adafruit_BusIO_Register *_ctrl0_reg = NULL, *_ctrl1_reg = NULL,
-                          *_ctrl2_reg = NULL, *_status_reg = NULL;
+  bool measure(int32_t raw[3]);
+  void cacheSample(const int32_t raw[3]);
+  void rawToEvent(const int32_t raw[3], sensors_event_t *event,
+                  uint32_t timestamp);
+  void unpack(const uint8_t buffer[9], int32_t raw[3]);
+  bool readRegisters(uint8_t reg, uint8_t *buffer, uint8_t len);
+  bool writeRegister(uint8_t reg, uint8_t value);
 
   uint16_t _odr_cache = 0;
+  uint32_t _bus_speed = MMC56X3_I2C_STANDARD;
+  uint16_t _transaction_overhead = MMC56X3_TRANSACTION_OVERHEAD_US;
+  mmc56x3_read_strategy_t _read_strategy = MMC56X3_READ_SEPARATE;
+  uint8_t _last_status = 0;
   uint8_t _ctrl2_cache = 0;
 
   int32_t x; ///< x-axis raw data
@@ -87,7 +344,27 @@ private:
 
   int32_t _sensorID;
 
+  mmc56x3_raw_callback_t _raw_callback = NULL;     ///< raw sample hook
+  void *_raw_context = NULL;                       ///< raw hook context
+  mmc56x3_event_callback_t _event_callback = NULL; ///< event hook
+  void *_event_context = NULL;                     ///< event hook context
+
+  uint32_t _service_due = 0; ///< micros() of service()'s next bus access
+  bool _converting = false;  ///< service() has a one-shot in progress
+
+  mmc56x3_sample_t _cache;    ///< latest sample, stamped with micros()
+  uint32_t _cache_millis = 0; ///< millis() of the latest sample
+  bool _cache_valid = false;  ///< _cache holds a sample
+  uint32_t _max_age = 0;      ///< cache window in us, 0 for off
+  uint32_t _cache_hits = 0;   ///< reads served from _cache
+  uint32_t _cache_misses = 0; ///< reads that measured, cache enabled
+
   Adafruit_I2CDevice *i2c_dev = NULL;
+
+  Adafruit_MMC56x3_BlockingTransfer _blocking; ///< default transfer
+  Adafruit_MMC56x3_Transfer *_transfer = NULL; ///< register transport
+  uint8_t _read_buffer[9];                     ///< async data read target
+  bool _read_pending = false;                  ///< read started, not finished
 };
 
 #endif
@@ -0,0 +1,194 @@
+/*!
+ * @file Adafruit_MMC56x3_ACCurrent.cpp
+ *
+ * Contactless AC current measurement from the field around a conductor,
+ * using windowed RMS and peak values of the MMC5603's high rate output.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_ACCurrent.h"
+#include "Adafruit_MMC56x3_Math.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new AC current meter, sensing along x
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_ACCurrent::Adafruit_MMC56x3_ACCurrent(void) {
+  setDirection(1, 0, 0);
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the meter, and optionally puts the sensor into
+    continuous mode at its highest output rate (1000 Hz)
+    @param mmc Sensor to configure, or NULL to leave it alone
+    @param window_len Samples per RMS/peak window, ideally a whole number of
+    line cycles (200 at 1000 Hz covers 10 cycles of 50 Hz or 12 of 60 Hz)
+    @param hp_shift High-pass time constant as a power of two in samples,
+    8 tracks the DC level with a 256 sample time constant
+    @returns True if the parameters are usable
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_ACCurrent::begin(Adafruit_MMC5603 *mmc,
+                                       uint16_t window_len, uint8_t hp_shift) {
+  if ((window_len == 0) || (hp_shift > 16)) {
+    return false;
+  }
+  _window_len = window_len;
+  _hp_shift = hp_shift;
+  reset();
+
+  if (mmc) {
+    mmc->setDataRate(1000);
+    mmc->setContinuousMode(true);
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clears the running window, latched results and DC tracker
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_ACCurrent::reset(void) {
+  memset(_dc, 0, sizeof(_dc));
+  memset(_sum_sq, 0, sizeof(_sum_sq));
+  memset(_peak, 0, sizeof(_peak));
+  memset(_rms_out, 0, sizeof(_rms_out));
+  memset(_peak_out, 0, sizeof(_peak_out));
+  _count = 0;
+  _primed = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the direction the conductor's field is sensed along, in
+    sensor axes. Usually perpendicular to both the wire and the line from
+    the wire to the sensor.
+    @param x X component, need not be normalized
+    @param y Y component
+    @param z Z component
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_ACCurrent::setDirection(float x, float y, float z) {
+  float norm = sqrtf(x * x + y * y + z * z);
+  if (norm == 0) {
+    return;
+  }
+  _dir[0] = lround(x / norm * 16384);
+  _dir[1] = lround(y / norm * 16384);
+  _dir[2] = lround(z / norm * 16384);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the conversion from field to current for getCurrent().
+    For a long straight wire at distance r meters this is
+    2 * PI * r / (4e-7 * PI * 1e6) = 5 * r amps per uT.
+    @param amps_per_ut Amps of conductor current per uT of sensed field
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_ACCurrent::setScale(float amps_per_ut) {
+  _amps_per_ut = amps_per_ut;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Feeds in one sample, which should arrive at a steady rate
+    @param raw The x, y and z raw counts, e.g. from readRaw()
+    @returns True when this sample completed a window and new RMS and peak
+    values are available
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_ACCurrent::update(const int32_t raw[3]) {
+  if (_window_len == 0) {
+    return false;
+  }
+
+  // start the DC tracker on the first sample rather than ramping from 0
+  if (!_primed) {
+    for (uint8_t a = 0; a < 3; a++) {
+      _dc[a] = (int64_t)raw[a] << _hp_shift;
+    }
+    _primed = true;
+  }
+
+  int32_t ac[4];
+  int64_t along = 0;
+  for (uint8_t a = 0; a < 3; a++) {
+    // the level keeps hp_shift fractional bits, so even long time
+    // constants follow the input with no dead band
+    _dc[a] += raw[a] - (int32_t)(_dc[a] >> _hp_shift);
+    ac[a] = raw[a] - (int32_t)(_dc[a] >> _hp_shift);
+    along += (int64_t)ac[a] * _dir[a];
+  }
+  ac[MMC56X3_AC_DIRECTION] = (int32_t)(along >> 14);
+
+  for (uint8_t c = 0; c < 4; c++) {
+    uint32_t mag = (ac[c] < 0) ? -ac[c] : ac[c];
+    _sum_sq[c] += (uint64_t)mag * mag;
+    if (mag > _peak[c]) {
+      _peak[c] = mag;
+    }
+  }
+
+  if (++_count < _window_len) {
+    return false;
+  }
+
+  for (uint8_t c = 0; c < 4; c++) {
+    _rms_out[c] = mmc56x3_isqrt64(_sum_sq[c] / _window_len);
+    _peak_out[c] = _peak[c];
+    _sum_sq[c] = 0;
+    _peak[c] = 0;
+  }
+  _count = 0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the RMS field of the last complete window
+    @param channel 0, 1 or 2 for x, y or z, or MMC56X3_AC_DIRECTION
+    @returns RMS of the AC field in uTesla
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_ACCurrent::getRMS(uint8_t channel) {
+  if (channel > MMC56X3_AC_DIRECTION) {
+    return NAN;
+  }
+  return _rms_out[channel] * MMC56X3_LSB_UT;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the largest AC field magnitude seen in the last complete
+    window
+    @param channel 0, 1 or 2 for x, y or z, or MMC56X3_AC_DIRECTION
+    @returns Peak of the AC field in uTesla
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_ACCurrent::getPeak(uint8_t channel) {
+  if (channel > MMC56X3_AC_DIRECTION) {
+    return NAN;
+  }
+  return _peak_out[channel] * MMC56X3_LSB_UT;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the conductor current from the RMS field along the sensing
+    direction, using the scale set with setScale()
+    @returns RMS current in amps
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_ACCurrent::getCurrent(void) {
+  return getRMS(MMC56X3_AC_DIRECTION) * _amps_per_ut;
+}
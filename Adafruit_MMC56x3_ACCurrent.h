@@ -0,0 +1,61 @@
+/*!
+ * @file Adafruit_MMC56x3_ACCurrent.h
+ *
+ * Contactless AC current measurement from the field around a conductor,
+ * using windowed RMS and peak values of the MMC5603's high rate output.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_ACCURRENT_H
+#define MMC56X3_ACCURRENT_H
+
+#include "Adafruit_MMC56x3.h"
+
+#define MMC56X3_AC_DIRECTION 3 //!< Channel index for the sensing direction
+
+/**************************************************************************/
+/*!
+    @brief  Removes the DC (earth and magnet) field from raw samples with a
+    tracking high-pass, then keeps running sums to produce RMS and peak
+    values over tumbling windows for each axis, and along one sensing
+    direction. No samples are buffered.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_ACCurrent {
+public:
+  Adafruit_MMC56x3_ACCurrent(void);
+
+  bool begin(Adafruit_MMC5603 *mmc = NULL, uint16_t window_len = 200,
+             uint8_t hp_shift = 8);
+  void reset(void);
+
+  void setDirection(float x, float y, float z);
+  void setScale(float amps_per_ut);
+
+  bool update(const int32_t raw[3]);
+
+  float getRMS(uint8_t channel = MMC56X3_AC_DIRECTION);
+  float getPeak(uint8_t channel = MMC56X3_AC_DIRECTION);
+  float getCurrent(void);
+
+private:
+  int64_t _dc[3];        ///< tracked DC level per axis, hp_shift frac bits
+  int32_t _dir[3];       ///< unit sensing direction, Q14
+  uint64_t _sum_sq[4];   ///< running sum of squares this window
+  uint32_t _peak[4];     ///< running peak magnitude this window
+  uint32_t _rms_out[4];  ///< latched RMS of the last full window, counts
+  uint32_t _peak_out[4]; ///< latched peak of the last full window, counts
+
+  float _amps_per_ut = 0;
+  uint16_t _window_len = 0;
+  uint16_t _count = 0;
+  uint8_t _hp_shift = 8;
+  bool _primed = false;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/*!
+ * @file Adafruit_MMC56x3_AHRS.cpp
+ *
+ * Lightweight orientation (AHRS) filter combining the MMC5603 with an
+ * external accelerometer, and optionally a gyroscope
+ *
+ * Based on the Madgwick MARG filter (S. Madgwick, "An efficient
+ * orientation filter for inertial and inertial/magnetic sensor arrays").
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_AHRS.h"
+
+/*!
+    @brief  Fast approximate 1 / sqrt(x), one Newton step (~0.2% error)
+    @param x Value, greater than zero
+    @returns Approximately 1 / sqrt(x)
+*/
+static float invSqrt(float x) {
+  float halfx = 0.5f * x;
+  float y = x;
+  uint32_t i;
+  memcpy(&i, &y, sizeof(i));
+  i = 0x5f3759df - (i >> 1);
+  memcpy(&y, &i, sizeof(y));
+  y = y * (1.5f - (halfx * y * y));
+  return y;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new filter at 100 Hz with the identity rotation
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_AHRS::Adafruit_MMC56x3_AHRS(void) {}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the update rate and gain, and resets the orientation
+    @param sample_rate How often update() is called, in Hz, normally the
+    magnetometer's data rate
+    @param beta Filter gain, higher converges faster but is noisier
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_AHRS::begin(float sample_rate, float beta) {
+  _dt = 1.0f / sample_rate;
+  _beta = beta;
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Resets the orientation to the identity rotation
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_AHRS::reset(void) {
+  _q0 = 1;
+  _q1 = _q2 = _q3 = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Runs one filter step with gyroscope, accelerometer and
+    magnetometer data. Accelerometer and magnetometer units do not matter
+    since both are normalized, but they must share the sensor's axes.
+    @param gx Gyro x rate in radians/s
+    @param gy Gyro y rate in radians/s
+    @param gz Gyro z rate in radians/s
+    @param ax Accelerometer x
+    @param ay Accelerometer y
+    @param az Accelerometer z
+    @param mx Calibrated magnetic x, e.g. uTesla
+    @param my Calibrated magnetic y
+    @param mz Calibrated magnetic z
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_AHRS::update(float gx, float gy, float gz, float ax,
+                                   float ay, float az, float mx, float my,
+                                   float mz) {
+  float q0 = _q0, q1 = _q1, q2 = _q2, q3 = _q3;
+
+  // rate of change of quaternion from gyroscope
+  float qDot1 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+  float qDot2 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+  float qDot3 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+  float qDot4 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+  // only correct when both reference vectors are valid
+  if (((ax != 0) || (ay != 0) || (az != 0)) &&
+      ((mx != 0) || (my != 0) || (mz != 0))) {
+    float recipNorm = invSqrt(ax * ax + ay * ay + az * az);
+    ax *= recipNorm;
+    ay *= recipNorm;
+    az *= recipNorm;
+
+    recipNorm = invSqrt(mx * mx + my * my + mz * mz);
+    mx *= recipNorm;
+    my *= recipNorm;
+    mz *= recipNorm;
+
+    // auxiliary variables to avoid repeated arithmetic
+    float _2q0mx = 2.0f * q0 * mx;
+    float _2q0my = 2.0f * q0 * my;
+    float _2q0mz = 2.0f * q0 * mz;
+    float _2q1mx = 2.0f * q1 * mx;
+    float _2q0 = 2.0f * q0;
+    float _2q1 = 2.0f * q1;
+    float _2q2 = 2.0f * q2;
+    float _2q3 = 2.0f * q3;
+    float _2q0q2 = 2.0f * q0 * q2;
+    float _2q2q3 = 2.0f * q2 * q3;
+    float q0q0 = q0 * q0;
+    float q0q1 = q0 * q1;
+    float q0q2 = q0 * q2;
+    float q0q3 = q0 * q3;
+    float q1q1 = q1 * q1;
+    float q1q2 = q1 * q2;
+    float q1q3 = q1 * q3;
+    float q2q2 = q2 * q2;
+    float q2q3 = q2 * q3;
+    float q3q3 = q3 * q3;
+
+    // reference direction of earth's magnetic field
+    float hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 +
+               _2q1 * my * q2 + _2q1 * mz * q3 - mx * q2q2 - mx * q3q3;
+    float hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 -
+               my * q1q1 + my * q2q2 + _2q2 * mz * q3 - my * q3q3;
+    float _2bx = sqrtf(hx * hx + hy * hy);
+    float _2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 -
+                 mz * q1q1 + _2q2 * my * q3 - mz * q2q2 + mz * q3q3;
+    float _4bx = 2.0f * _2bx;
+    float _4bz = 2.0f * _2bz;
+
+    // objective function errors, shared by the gradient terms
+    float fax = 2.0f * q1q3 - _2q0q2 - ax;
+    float fay = 2.0f * q0q1 + _2q2q3 - ay;
+    float faz = 1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az;
+    float fmx = _2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx;
+    float fmy = _2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my;
+    float fmz = _2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz;
+
+    // gradient descent corrective step
+    float s0 = -_2q2 * fax + _2q1 * fay - _2bz * q2 * fmx +
+               (-_2bx * q3 + _2bz * q1) * fmy + _2bx * q2 * fmz;
+    float s1 = _2q3 * fax + _2q0 * fay - 2.0f * _2q1 * faz +
+               _2bz * q3 * fmx + (_2bx * q2 + _2bz * q0) * fmy +
+               (_2bx * q3 - _4bz * q1) * fmz;
+    float s2 = -_2q0 * fax + _2q3 * fay - 2.0f * _2q2 * faz +
+               (-_4bx * q2 - _2bz * q0) * fmx + (_2bx * q1 + _2bz * q3) * fmy +
+               (_2bx * q0 - _4bz * q2) * fmz;
+    float s3 = _2q1 * fax + _2q2 * fay + (-_4bx * q3 + _2bz * q1) * fmx +
+               (-_2bx * q0 + _2bz * q2) * fmy + _2bx * q1 * fmz;
+
+    float sn = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+    if (sn > 0) {
+      recipNorm = invSqrt(sn);
+      qDot1 -= _beta * s0 * recipNorm;
+      qDot2 -= _beta * s1 * recipNorm;
+      qDot3 -= _beta * s2 * recipNorm;
+      qDot4 -= _beta * s3 * recipNorm;
+    }
+  }
+
+  // integrate and normalize
+  q0 += qDot1 * _dt;
+  q1 += qDot2 * _dt;
+  q2 += qDot3 * _dt;
+  q3 += qDot4 * _dt;
+
+  float recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+  _q0 = q0 * recipNorm;
+  _q1 = q1 * recipNorm;
+  _q2 = q2 * recipNorm;
+  _q3 = q3 * recipNorm;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Runs one filter step without a gyroscope, so the orientation
+    settles on the accelerometer and magnetometer directions at a rate set
+    by beta
+    @param ax Accelerometer x
+    @param ay Accelerometer y
+    @param az Accelerometer z
+    @param mx Calibrated magnetic x, e.g. uTesla
+    @param my Calibrated magnetic y
+    @param mz Calibrated magnetic z
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_AHRS::update(float ax, float ay, float az, float mx,
+                                   float my, float mz) {
+  update(0, 0, 0, ax, ay, az, mx, my, mz);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the current orientation
+    @param w Filled with the scalar part
+    @param x Filled with the x part
+    @param y Filled with the y part
+    @param z Filled with the z part
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_AHRS::getQuaternion(float *w, float *x, float *y,
+                                          float *z) {
+  *w = _q0;
+  *x = _q1;
+  *y = _q2;
+  *z = _q3;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the roll angle of the current orientation
+    @returns Roll in degrees
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_AHRS::getRoll(void) {
+  return atan2f(_q0 * _q1 + _q2 * _q3, 0.5f - _q1 * _q1 - _q2 * _q2) *
+         RAD_TO_DEG;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the pitch angle of the current orientation
+    @returns Pitch in degrees
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_AHRS::getPitch(void) {
+  float s = -2.0f * (_q1 * _q3 - _q0 * _q2);
+  if (s > 1) {
+    s = 1;
+  } else if (s < -1) {
+    s = -1;
+  }
+  return asinf(s) * RAD_TO_DEG;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the yaw (magnetic heading) of the current orientation
+    @returns Yaw in degrees
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_AHRS::getYaw(void) {
+  return atan2f(_q1 * _q2 + _q0 * _q3, 0.5f - _q2 * _q2 - _q3 * _q3) *
+         RAD_TO_DEG;
+}
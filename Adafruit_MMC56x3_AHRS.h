@@ -0,0 +1,52 @@
+/*!
+ * @file Adafruit_MMC56x3_AHRS.h
+ *
+ * Lightweight orientation (AHRS) filter combining the MMC5603 with an
+ * external accelerometer, and optionally a gyroscope
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_AHRS_H
+#define MMC56X3_AHRS_H
+
+#include "Arduino.h"
+
+/**************************************************************************/
+/*!
+    @brief  Madgwick gradient descent orientation filter in single
+    precision, with no double math and no trig in the update path. Produces
+    a sensor-to-earth quaternion with x pointing to magnetic north.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_AHRS {
+public:
+  Adafruit_MMC56x3_AHRS(void);
+
+  void begin(float sample_rate, float beta = 0.1f);
+  void reset(void);
+
+  void update(float gx, float gy, float gz, float ax, float ay, float az,
+              float mx, float my, float mz);
+  void update(float ax, float ay, float az, float mx, float my, float mz);
+
+  void getQuaternion(float *w, float *x, float *y, float *z);
+  float getRoll(void);
+  float getPitch(void);
+  float getYaw(void);
+
+  /*! @brief Sets the filter gain, higher trusts accel/mag more than gyro
+      @param beta The new gain */
+  void setBeta(float beta) { _beta = beta; }
+
+private:
+  float _q0 = 1, _q1 = 0, _q2 = 0, _q3 = 0; ///< orientation quaternion
+  float _beta = 0.1f;                       ///< gradient step gain
+  float _dt = 0.01f;                        ///< seconds between updates
+};
+
+#endif
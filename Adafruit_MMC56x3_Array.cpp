@@ -0,0 +1,145 @@
+/*!
+ * @file Adafruit_MMC56x3_Array.cpp
+ *
+ * Synchronized acquisition from an array of MMC5603 sensors spread over one
+ * or more I2C buses, merged into time-stamped frames
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Array.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates an empty array
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_Array::Adafruit_MMC56x3_Array(void) {
+  memset(&_frame, 0, sizeof(_frame));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds a sensor. Each should already be begin()'d on its own bus
+    and address, e.g. the same address on Wire and Wire1.
+    @param mmc The sensor
+    @returns Sensor number, its index in frames, or -1 if the array is full
+*/
+/**************************************************************************/
+int8_t Adafruit_MMC56x3_Array::addSensor(Adafruit_MMC5603 *mmc) {
+  if (!mmc || (_num >= MMC56X3_ARRAY_MAX_SENSORS) || (_num >= 32)) {
+    return -1;
+  }
+  _sensors[_num] = mmc;
+  return _num++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Starts a frame by triggering every one-shot sensor
+    @returns False if a frame is already in progress or there are no sensors
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Array::start(void) {
+  if (_busy || (_num == 0)) {
+    return false;
+  }
+
+  uint32_t longest = 0;
+  _frame.valid = 0;
+  _frame.timestamp = micros();
+  _pending = 0;
+  for (uint8_t i = 0; i < _num; i++) {
+    Adafruit_MMC5603 *mmc = _sensors[i];
+    _frame.skew[i] = micros() - _frame.timestamp;
+    // continuous mode sensors have data waiting, pending just means read it
+    if (mmc->isContinuousMode() || mmc->startMeasurement()) {
+      _pending |= 1UL << i;
+      if (mmc->getMeasurementTime() > longest) {
+        longest = mmc->getMeasurementTime();
+      }
+    }
+  }
+
+  // the first status checks are due once the last trigger has converted
+  uint32_t now = micros();
+  _next_poll = now + longest;
+  _deadline = now + 2 * longest + 1000;
+  _busy = true;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Advances the frame in progress, reading each sensor that has
+    finished. Returns straight away until the conversions are due.
+    @param frame Filled in when the frame completes
+    @returns True when the frame is complete (check its valid bits)
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Array::poll(mmc56x3_frame_t *frame) {
+  if (!_busy) {
+    return false;
+  }
+  uint32_t now = micros();
+  if ((int32_t)(now - _next_poll) < 0) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < _num; i++) {
+    uint32_t bit = 1UL << i;
+    if (!(_pending & bit) || !_sensors[i]->isDataReady()) {
+      continue;
+    }
+    if (_sensors[i]->readMeasurement(_frame.raw[i])) {
+      _frame.valid |= bit;
+    }
+    _pending &= ~bit;
+  }
+
+  if (_pending && ((int32_t)(micros() - _deadline) < 0)) {
+    _next_poll = micros() + MMC56X3_ARRAY_POLL_US;
+    return false;
+  }
+  finish(frame);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Acquires a whole frame, waiting for the conversions
+    @param frame Filled with the frame
+    @returns True if every sensor was read
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Array::acquire(mmc56x3_frame_t *frame) {
+  if (!start()) {
+    return false;
+  }
+  while (!poll(frame)) {
+    yield();
+  }
+  return frame->valid == ((_num == 32) ? 0xFFFFFFFFUL : (1UL << _num) - 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Hands out the completed frame and counts sensors that never
+    became ready
+    @param frame Filled with the frame
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Array::finish(mmc56x3_frame_t *frame) {
+  for (uint8_t i = 0; i < _num; i++) {
+    if (_pending & (1UL << i)) {
+      _timeouts++;
+    }
+  }
+  _pending = 0;
+  _busy = false;
+  *frame = _frame;
+}
@@ -0,0 +1,76 @@
+/*!
+ * @file Adafruit_MMC56x3_Array.h
+ *
+ * Synchronized acquisition from an array of MMC5603 sensors spread over one
+ * or more I2C buses, merged into time-stamped frames
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_ARRAY_H
+#define MMC56X3_ARRAY_H
+
+#include "Adafruit_MMC56x3.h"
+
+#ifndef MMC56X3_ARRAY_MAX_SENSORS
+#define MMC56X3_ARRAY_MAX_SENSORS 8 //!< Sensors per array, up to 32
+#endif
+
+#define MMC56X3_ARRAY_POLL_US 200 //!< Status re-check interval, us
+
+/*!
+ * @brief One reading from every sensor in an array
+ */
+typedef struct {
+  uint32_t timestamp;                        ///< micros() at the first trigger
+  uint32_t valid;                            ///< bit n set if sensor n was read
+  uint16_t skew[MMC56X3_ARRAY_MAX_SENSORS];  ///< trigger time - timestamp
+  int32_t raw[MMC56X3_ARRAY_MAX_SENSORS][3]; ///< x, y, z raw counts
+} mmc56x3_frame_t;
+
+/**************************************************************************/
+/*!
+    @brief  Triggers every sensor of the array back to back so they all
+    convert at once, whichever bus they are on, then collects the results
+    as each finishes. A frame therefore takes one conversion time plus the
+    bus transfers, rather than a conversion per sensor. Uses the
+    non-blocking measurement steps, so poll() can share loop() with other
+    work.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Array {
+public:
+  Adafruit_MMC56x3_Array(void);
+
+  int8_t addSensor(Adafruit_MMC5603 *mmc);
+  /*! @brief Sensors in the array @returns Sensor count */
+  uint8_t getNumSensors(void) { return _num; }
+
+  bool start(void);
+  bool poll(mmc56x3_frame_t *frame);
+  bool acquire(mmc56x3_frame_t *frame);
+
+  /*! @brief Whether a frame is being acquired @returns True if started */
+  bool isBusy(void) { return _busy; }
+  /*! @brief Sensors that missed a frame by never becoming ready
+      @returns Timeout count */
+  uint32_t getTimeouts(void) { return _timeouts; }
+
+private:
+  void finish(mmc56x3_frame_t *frame);
+
+  Adafruit_MMC5603 *_sensors[MMC56X3_ARRAY_MAX_SENSORS];
+  mmc56x3_frame_t _frame;  ///< frame being acquired
+  uint32_t _pending = 0;   ///< sensors not read yet
+  uint32_t _next_poll = 0; ///< micros() of the next status check
+  uint32_t _deadline = 0;  ///< micros() after which stragglers are dropped
+  uint32_t _timeouts = 0;  ///< sensors dropped from frames
+  uint8_t _num = 0;        ///< sensors added
+  bool _busy = false;      ///< frame in progress
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*!
+ * @file Adafruit_MMC56x3_Broadcast.h
+ *
+ * Single writer, multiple reader broadcast ring for MMC5603 samples, where
+ * every consumer sees every sample through its own cursor
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_BROADCAST_H
+#define MMC56X3_BROADCAST_H
+
+#include "Adafruit_MMC56x3.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+// single core, only the compiler can reorder
+#define MMC56X3_BARRIER() __asm__ __volatile__("" ::: "memory") //!< fence
+#else
+#define MMC56X3_BARRIER() __sync_synchronize() //!< full memory fence
+#endif
+
+/*!
+    @brief  A consumer's position in a broadcast ring. Each consumer owns
+    one, so readers never write shared state.
+*/
+typedef struct {
+  uint32_t next; ///< sequence number of the next sample to read
+  uint32_t lost; ///< samples overwritten before this consumer got to them
+} mmc56x3_cursor_t;
+
+/**************************************************************************/
+/*!
+    @brief  Broadcast ring of N slots (a power of two). The writer, which
+    may be an interrupt or another core, never waits for readers: a reader
+    that falls more than N samples behind is lapped, skips ahead to the
+    oldest sample still held and counts the loss. Each slot carries the
+    sequence number of its sample, so a zero-copy reader can tell whether
+    the writer reused the slot while it was looking at it.
+    @tparam N Number of slots, a power of two
+    @tparam T Sample type, copied by assignment
+*/
+/**************************************************************************/
+template <uint16_t N, typename T = mmc56x3_sample_t>
+class Adafruit_MMC56x3_Broadcast {
+  static_assert((N >= 2) && ((N & (N - 1)) == 0),
+                "broadcast ring size must be a power of two");
+
+public:
+  /*! @brief Writer side, gets the next slot to fill in place. Readers
+      will not see it until publish() is called.
+      @returns The slot to fill */
+  T *claim(void) {
+    Slot &s = _slots[_head & (N - 1)];
+    store(s.seq, 0); // invalidate for readers still on the old sample
+    MMC56X3_BARRIER();
+    return &s.data;
+  }
+
+  /*! @brief Writer side, makes the slot from claim() visible to readers */
+  void publish(void) {
+    MMC56X3_BARRIER();
+    store(_slots[_head & (N - 1)].seq, _head + 1);
+    MMC56X3_BARRIER();
+    store(_head_shared, ++_head);
+  }
+
+  /*! @brief Writer side, copies a sample in and publishes it
+      @param sample The sample */
+  void push(const T &sample) {
+    *claim() = sample;
+    publish();
+  }
+
+  /*! @brief Starts a consumer at the next sample to be written
+      @param c The consumer's cursor */
+  void attach(mmc56x3_cursor_t *c) {
+    c->next = load(_head_shared);
+    c->lost = 0;
+  }
+
+  /*! @brief Moves a consumer on to the newest sample, for consumers that
+      only want current data. Skipped samples are not counted as lost.
+      @param c The consumer's cursor */
+  void skipToLatest(mmc56x3_cursor_t *c) {
+    uint32_t head = load(_head_shared);
+    if (head != c->next) {
+      c->next = head - 1;
+    }
+  }
+
+  /*! @brief Samples waiting for a consumer, at most N
+      @param c The consumer's cursor
+      @returns Number of unread samples */
+  uint32_t available(const mmc56x3_cursor_t *c) {
+    uint32_t n = load(_head_shared) - c->next;
+    return (n > N) ? N : n;
+  }
+
+  /*! @brief Zero-copy read of the consumer's next sample. The pointer is
+      into the ring, so call release() once done with it to find out if
+      the writer overwrote it in the meantime.
+      @param c The consumer's cursor
+      @returns The sample, or NULL if there is nothing new */
+  const T *peek(mmc56x3_cursor_t *c) {
+    for (;;) {
+      uint32_t head = load(_head_shared);
+      if (head == c->next) {
+        return NULL;
+      }
+      if (head - c->next > N) { // lapped, skip to the oldest still held
+        c->lost += head - c->next - N;
+        c->next = head - N;
+      }
+      Slot &s = _slots[c->next & (N - 1)];
+      if (load(s.seq) == c->next + 1) {
+        MMC56X3_BARRIER();
+        return &s.data;
+      }
+      // being rewritten right now, so this one is gone too
+      c->lost++;
+      c->next++;
+    }
+  }
+
+  /*! @brief Finishes with the sample from peek() and moves on
+      @param c The consumer's cursor
+      @returns True if the sample was intact the whole time, false if it
+      was overwritten and whatever was read from it must be discarded */
+  bool release(mmc56x3_cursor_t *c) {
+    MMC56X3_BARRIER();
+    bool intact = load(_slots[c->next & (N - 1)].seq) == c->next + 1;
+    if (!intact) {
+      c->lost++;
+    }
+    c->next++;
+    return intact;
+  }
+
+  /*! @brief Copying read of the consumer's next sample, retrying if it
+      is overwritten mid copy
+      @param c The consumer's cursor
+      @param sample Filled with the sample
+      @returns True if a sample was returned */
+  bool read(mmc56x3_cursor_t *c, T *sample) {
+    const T *p;
+    while ((p = peek(c)) != NULL) {
+      *sample = *p;
+      if (release(c)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*! @brief Samples written since construction
+      @returns Sequence number of the next sample */
+  uint32_t getHead(void) { return load(_head_shared); }
+
+private:
+  struct Slot {
+    volatile uint32_t seq = 0; // sequence + 1 of the sample held, 0 if none
+    T data;
+  };
+
+  // AVR reads a uint32_t a byte at a time, so an interrupt writer could
+  // tear it; block interrupts for the few cycles of the copy
+  static uint32_t load(const volatile uint32_t &v) {
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t r = v;
+    SREG = sreg;
+    return r;
+#else
+    return v;
+#endif
+  }
+
+  static void store(volatile uint32_t &v, uint32_t value) {
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+    v = value;
+    SREG = sreg;
+#else
+    v = value;
+#endif
+  }
+
+  Slot _slots[N];
+  uint32_t _head = 0;                 // writer's private copy
+  volatile uint32_t _head_shared = 0; // what readers see
+};
+
+#endif
@@ -0,0 +1,188 @@
+/*!
+ * @file Adafruit_MMC56x3_Capture.cpp
+ *
+ * Capture file format for long, high rate MMC5603 recordings: a fixed
+ * header with the sensor setup and calibration followed by fixed size
+ * binary records
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Capture.h"
+
+static const char capture_magic[8] = {'M', 'M', 'C', '5', '6', 'C', 'A', 'P'};
+
+/*!
+    @brief  Stores a little endian value
+    @param p Where to store it
+    @param v The value
+    @param len Number of bytes
+*/
+static void putLE(uint8_t *p, uint32_t v, uint8_t len) {
+  for (uint8_t i = 0; i < len; i++) {
+    p[i] = v >> (8 * i);
+  }
+}
+
+/*!
+    @brief  Loads a little endian value
+    @param p Where to load it from
+    @param len Number of bytes
+    @returns The value
+*/
+static uint32_t getLE(const uint8_t *p, uint8_t len) {
+  uint32_t v = 0;
+  for (uint8_t i = 0; i < len; i++) {
+    v |= (uint32_t)p[i] << (8 * i);
+  }
+  return v;
+}
+
+/*!
+    @brief  Stores a float as its IEEE 754 bits, little endian
+    @param p Where to store it
+    @param f The value
+*/
+static void putFloat(uint8_t *p, float f) {
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+  putLE(p, bits, 4);
+}
+
+/*!
+    @brief  Loads a float from its IEEE 754 bits, little endian
+    @param p Where to load it from
+    @returns The value
+*/
+static float getFloat(const uint8_t *p) {
+  uint32_t bits = getLE(p, 4);
+  float f;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a capture writer with no output
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_Capture::Adafruit_MMC56x3_Capture(void) {}
+
+/**************************************************************************/
+/*!
+    @brief  Fills in a config with no calibration (zero offset, identity
+    matrix) and one sensor, taking the rate and mode from a sensor if given
+    @param config The config to fill in
+    @param mmc Sensor to read the data rate and mode from, or NULL
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Capture::defaultConfig(mmc56x3_capture_config_t *config,
+                                             Adafruit_MMC5603 *mmc) {
+  memset(config, 0, sizeof(*config));
+  config->sensors = 1;
+  for (uint8_t i = 0; i < 3; i++) {
+    config->soft_iron[i][i] = 1;
+  }
+  if (mmc) {
+    config->data_rate = mmc->getDataRate();
+    config->continuous = mmc->isContinuousMode();
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Writes the header, starting a new capture
+    @param out File or other Print, positioned at its start
+    @param config The recording setup
+    @returns True if the whole header was written
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Capture::begin(Print *out,
+                                     const mmc56x3_capture_config_t *config) {
+  uint8_t header[MMC56X3_CAPTURE_HEADER_LEN];
+  encodeHeader(config, header);
+  _stream.begin(out);
+  _records = 0;
+  return out->write(header, sizeof(header)) == sizeof(header);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Appends one record
+    @param sample The sample, e.g. filled by readRaw() and micros()
+    @param sensor Sensor number 0-15
+    @returns True if the whole record was written
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Capture::write(const mmc56x3_sample_t *sample,
+                                     uint8_t sensor) {
+  if (!_stream.write(sample, sensor)) {
+    return false;
+  }
+  _records++;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Packs a config into header bytes
+    @param config The recording setup
+    @param header Filled with MMC56X3_CAPTURE_HEADER_LEN bytes
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Capture::encodeHeader(
+    const mmc56x3_capture_config_t *config,
+    uint8_t header[MMC56X3_CAPTURE_HEADER_LEN]) {
+  memset(header, 0, MMC56X3_CAPTURE_HEADER_LEN);
+  memcpy(header, capture_magic, sizeof(capture_magic));
+  putLE(header + 8, MMC56X3_CAPTURE_VERSION, 2);
+  putLE(header + 10, MMC56X3_CAPTURE_HEADER_LEN, 2);
+  putLE(header + 12, MMC56X3_FRAME_LEN, 2);
+  putLE(header + 14, config->data_rate, 2);
+  header[16] = config->continuous;
+  header[17] = config->sensors;
+  putLE(header + 20, config->start_time, 4);
+  putFloat(header + 24, MMC56X3_LSB_UT);
+  for (uint8_t i = 0; i < 3; i++) {
+    putFloat(header + 28 + 4 * i, config->hard_iron[i]);
+    for (uint8_t j = 0; j < 3; j++) {
+      putFloat(header + 40 + 12 * i + 4 * j, config->soft_iron[i][j]);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Unpacks header bytes read back from a capture
+    @param header The bytes from the start of the file
+    @param len Number of bytes available
+    @param config Filled with the recording setup
+    @returns False if this is not a capture this version can read
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Capture::decodeHeader(const uint8_t *header,
+                                            uint16_t len,
+                                            mmc56x3_capture_config_t *config) {
+  if ((len < MMC56X3_CAPTURE_HEADER_LEN) ||
+      memcmp(header, capture_magic, sizeof(capture_magic)) ||
+      (getLE(header + 8, 2) != MMC56X3_CAPTURE_VERSION) ||
+      (getLE(header + 10, 2) != MMC56X3_CAPTURE_HEADER_LEN) ||
+      (getLE(header + 12, 2) != MMC56X3_FRAME_LEN)) {
+    return false;
+  }
+  config->data_rate = getLE(header + 14, 2);
+  config->continuous = header[16];
+  config->sensors = header[17];
+  config->start_time = getLE(header + 20, 4);
+  for (uint8_t i = 0; i < 3; i++) {
+    config->hard_iron[i] = getFloat(header + 28 + 4 * i);
+    for (uint8_t j = 0; j < 3; j++) {
+      config->soft_iron[i][j] = getFloat(header + 40 + 12 * i + 4 * j);
+    }
+  }
+  return true;
+}
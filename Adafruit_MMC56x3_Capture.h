@@ -0,0 +1,91 @@
+/*!
+ * @file Adafruit_MMC56x3_Capture.h
+ *
+ * Capture file format for long, high rate MMC5603 recordings: a fixed
+ * header with the sensor setup and calibration followed by fixed size
+ * binary records
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_CAPTURE_H
+#define MMC56X3_CAPTURE_H
+
+#include "Adafruit_MMC56x3_Stream.h"
+
+/*=========================================================================
+    FILE LAYOUT, little endian
+    -----------------------------------------------------------------------
+    bytes 0-7    magic "MMC56CAP"
+    bytes 8-9    format version, MMC56X3_CAPTURE_VERSION
+    bytes 10-11  header length, MMC56X3_CAPTURE_HEADER_LEN
+    bytes 12-13  record length, MMC56X3_FRAME_LEN
+    bytes 14-15  output data rate in Hz
+    byte  16     1 if the sensor ran in continuous mode
+    byte  17     number of sensors recorded
+    bytes 18-19  reserved, 0
+    bytes 20-23  start time, seconds since 1970 or 0 if unknown
+    bytes 24-27  uTesla per raw count, float
+    bytes 28-39  hard iron offset x, y, z in uTesla, floats
+    bytes 40-75  soft iron matrix, row major, floats
+    bytes 76-79  reserved, 0
+    then records, each one Adafruit_MMC56x3_Stream frame, so record n is
+    at header length + n * record length
+    -----------------------------------------------------------------------*/
+#define MMC56X3_CAPTURE_VERSION 1     //!< Format version written
+#define MMC56X3_CAPTURE_HEADER_LEN 80 //!< Header bytes before the records
+
+/*!
+ * @brief Recording setup stored in the capture header
+ */
+typedef struct {
+  uint16_t data_rate;    ///< output data rate in Hz
+  bool continuous;       ///< sensor was in continuous mode
+  uint8_t sensors;       ///< number of sensors recorded
+  uint32_t start_time;   ///< seconds since 1970, or 0 if unknown
+  float hard_iron[3];    ///< offset subtracted from x, y, z in uTesla
+  float soft_iron[3][3]; ///< matrix applied after the offset
+} mmc56x3_capture_config_t;
+
+/**************************************************************************/
+/*!
+    @brief  Writes a capture header and then records to any Print, usually
+    an SD card file. Every record is the same size, so readers can seek
+    straight to any sample, and a recording cut short by power loss is
+    still readable up to its last complete record.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Capture {
+public:
+  Adafruit_MMC56x3_Capture(void);
+
+  static void defaultConfig(mmc56x3_capture_config_t *config,
+                            Adafruit_MMC5603 *mmc = NULL);
+
+  bool begin(Print *out, const mmc56x3_capture_config_t *config);
+  bool write(const mmc56x3_sample_t *sample, uint8_t sensor = 0);
+
+  /*! @brief Records written since begin() @returns Record count */
+  uint32_t getRecords(void) { return _records; }
+
+  static void encodeHeader(const mmc56x3_capture_config_t *config,
+                           uint8_t header[MMC56X3_CAPTURE_HEADER_LEN]);
+  static bool decodeHeader(const uint8_t *header, uint16_t len,
+                           mmc56x3_capture_config_t *config);
+  /*! @brief Byte offset of a record, for seeking
+      @param index Record number from 0
+      @returns Offset from the start of the file */
+  static uint32_t recordOffset(uint32_t index) {
+    return MMC56X3_CAPTURE_HEADER_LEN + index * MMC56X3_FRAME_LEN;
+  }
+
+private:
+  Adafruit_MMC56x3_Stream _stream;
+  uint32_t _records = 0;
+};
+
+#endif
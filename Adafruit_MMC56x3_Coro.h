@@ -0,0 +1,202 @@
+/*!
+ * @file Adafruit_MMC56x3_Coro.h
+ *
+ * Optional C++20 coroutine interface, so sketches and host programs can
+ * co_await MMC5603 measurements from a small single threaded event loop
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_CORO_H
+#define MMC56X3_CORO_H
+
+#include "Adafruit_MMC56x3.h"
+
+#if defined(__has_include)
+#if (__cplusplus >= 202002L) && __has_include(<coroutine>)
+#define MMC56X3_HAS_COROUTINES //!< Compiler supports C++20 coroutines
+#endif
+#endif
+
+#ifdef MMC56X3_HAS_COROUTINES
+
+#include <coroutine>
+#include <stdlib.h>
+
+#ifndef MMC56X3_CORO_MAX_WAITERS
+#define MMC56X3_CORO_MAX_WAITERS 8 //!< Coroutines suspended at once
+#endif
+
+#define MMC56X3_CORO_POLL_US 500 //!< Status re-check interval, us
+
+/**************************************************************************/
+/*!
+    @brief  Single threaded event loop that resumes coroutines when a sleep
+    ends or a measurement is ready. Measurements use the non-blocking
+    driver steps, so one loop can keep many sensors converting at once.
+    Waiters live in a fixed table, only the coroutine frames themselves are
+    allocated by the compiler.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_EventLoop {
+public:
+  /*!
+      @brief  Return type of a coroutine run by the loop. It starts as soon
+      as it is called and frees itself when it finishes.
+  */
+  struct Task {
+    /*! @brief Coroutine promise, eager start and self cleanup */
+    struct promise_type {
+      /*! @brief Creates the (empty) Task handed to the caller
+          @returns The task */
+      Task get_return_object(void) { return Task(); }
+      /*! @brief Runs the body straight away @returns Never suspend */
+      std::suspend_never initial_suspend(void) { return {}; }
+      /*! @brief Frees the frame on completion @returns Never suspend */
+      std::suspend_never final_suspend(void) noexcept { return {}; }
+      /*! @brief Nothing to return */
+      void return_void(void) {}
+      /*! @brief Exceptions are not supported on most boards */
+      void unhandled_exception(void) { abort(); }
+    };
+  };
+
+  /*! @brief Awaitable that resumes after a delay */
+  struct SleepAwaiter {
+    Adafruit_MMC56x3_EventLoop *loop; ///< loop to wait on
+    uint32_t us;                      ///< delay in microseconds
+    /*! @brief Zero length sleeps do not suspend
+        @returns True if there is nothing to wait for */
+    bool await_ready(void) { return us == 0; }
+    /*! @brief Queues the coroutine
+        @param h The suspending coroutine
+        @returns False (carry on now) if the loop is full */
+    bool await_suspend(std::coroutine_handle<> h) {
+      return loop->add(h, micros() + us, NULL, NULL);
+    }
+    /*! @brief Nothing to hand back */
+    void await_resume(void) {}
+  };
+
+  /*! @brief Awaitable that takes one measurement */
+  struct MeasureAwaiter {
+    Adafruit_MMC56x3_EventLoop *loop; ///< loop to wait on
+    Adafruit_MMC5603 *mmc;            ///< sensor to measure
+    int32_t *raw;                     ///< filled with the x, y, z counts
+    uint32_t deadline;                ///< micros() to give up at
+    bool queued;                      ///< suspended rather than refused
+    bool done;                        ///< conversion finished in time
+    /*! @brief Always suspends @returns False */
+    bool await_ready(void) { return false; }
+    /*! @brief Triggers the measurement and queues the coroutine until the
+        conversion is predicted to be done
+        @param h The suspending coroutine
+        @returns False (carry on now) if triggering failed or the loop is
+        full */
+    bool await_suspend(std::coroutine_handle<> h) {
+      uint32_t now = micros();
+      uint32_t wait = mmc->getMeasurementTime();
+      deadline = now + 2 * wait + 1000;
+      if (!mmc->isContinuousMode() && !mmc->startMeasurement()) {
+        return queued = false;
+      }
+      return queued = loop->add(h, now + wait, check, this);
+    }
+    /*! @brief Reads the data once the loop found it ready
+        @returns True if raw was filled */
+    bool await_resume(void) {
+      return queued && done && mmc->readMeasurement(raw);
+    }
+    /*! @brief Loop hook, whether to resume yet
+        @param self The awaiter
+        @returns True when the data is ready or the deadline has passed */
+    static bool check(void *self) {
+      MeasureAwaiter *m = (MeasureAwaiter *)self;
+      m->done = m->mmc->isDataReady();
+      return m->done || ((int32_t)(micros() - m->deadline) >= 0);
+    }
+  };
+
+  /*! @brief co_await to pause the calling coroutine
+      @param us Microseconds to wait
+      @returns The awaitable */
+  SleepAwaiter sleep(uint32_t us) { return SleepAwaiter{this, us}; }
+
+  /*! @brief co_await to take a measurement without blocking the loop
+      @param mmc The sensor
+      @param raw Array of 3 filled with the x, y and z raw counts
+      @returns The awaitable, which gives true if raw was filled */
+  MeasureAwaiter measure(Adafruit_MMC5603 *mmc, int32_t raw[3]) {
+    return MeasureAwaiter{this, mmc, raw, 0, false, false};
+  }
+
+  /*! @brief Resumes every coroutine that is due and whose condition holds.
+      Call from loop(), or use run() to block.
+      @returns True while any coroutine is still waiting */
+  bool runOnce(void) {
+    for (uint8_t i = 0; i < MMC56X3_CORO_MAX_WAITERS; i++) {
+      waiter_t *w = &_waiters[i];
+      if (!w->handle || ((int32_t)(micros() - w->due) < 0)) {
+        continue;
+      }
+      if (w->ready && !w->ready(w->arg)) {
+        w->due = micros() + MMC56X3_CORO_POLL_US;
+        continue;
+      }
+      // free the slot first, the coroutine may wait again straight away
+      std::coroutine_handle<> h = w->handle;
+      w->handle = nullptr;
+      _count--;
+      h.resume();
+    }
+    return _count > 0;
+  }
+
+  /*! @brief Runs until no coroutine is waiting */
+  void run(void) {
+    while (runOnce()) {
+      yield();
+    }
+  }
+
+  /*! @brief Coroutines currently suspended @returns Waiter count */
+  uint8_t getWaiting(void) { return _count; }
+
+private:
+  /*! @brief A suspended coroutine and what it is waiting for */
+  typedef struct {
+    std::coroutine_handle<> handle; ///< coroutine to resume, or null
+    uint32_t due;                   ///< micros() of the next check
+    bool (*ready)(void *);          ///< extra condition, or NULL
+    void *arg;                      ///< passed to ready
+  } waiter_t;
+
+  /*! @brief Queues a coroutine
+      @param h The coroutine
+      @param due micros() to check it at
+      @param ready Extra condition to resume on, or NULL
+      @param arg Passed to ready
+      @returns False if the table is full */
+  bool add(std::coroutine_handle<> h, uint32_t due, bool (*ready)(void *),
+           void *arg) {
+    for (uint8_t i = 0; i < MMC56X3_CORO_MAX_WAITERS; i++) {
+      if (!_waiters[i].handle) {
+        _waiters[i] = waiter_t{h, due, ready, arg};
+        _count++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  waiter_t _waiters[MMC56X3_CORO_MAX_WAITERS] = {}; ///< suspended coroutines
+  uint8_t _count = 0;                                ///< waiters in use
+};
+
+#endif // MMC56X3_HAS_COROUTINES
+
+#endif
@@ -0,0 +1,307 @@
+/*!
+ * @file Adafruit_MMC56x3_FFT.cpp
+ *
+ * Fixed point spectrum snapshots of the MMC5603's high rate sample stream
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_FFT.h"
+
+/*! Quarter wave of sin(2 * PI * i / 1024) in Q15, i = 0..256 */
+static const int16_t sine_table[257] PROGMEM = {
+    0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809,
+    2009, 2210, 2410, 2611, 2811, 3012, 3212, 3412, 3612, 3811,
+    4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800,
+    5998, 6195, 6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767,
+    7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319, 9512, 9704,
+    9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605,
+    11793, 11980, 12167, 12353, 12539, 12725, 12910, 13094, 13279, 13462,
+    13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+    15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018,
+    17189, 17360, 17530, 17700, 17869, 18037, 18204, 18371, 18537, 18703,
+    18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317,
+    20475, 20631, 20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856,
+    22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027, 23170, 23311,
+    23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680,
+    24811, 24942, 25072, 25201, 25329, 25456, 25582, 25708, 25832, 25955,
+    26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+    27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208,
+    28310, 28411, 28510, 28609, 28706, 28803, 28898, 28992, 29085, 29177,
+    29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037,
+    30117, 30195, 30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783,
+    30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297, 31356, 31414,
+    31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926,
+    31971, 32014, 32057, 32098, 32137, 32176, 32213, 32250, 32285, 32318,
+    32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+    32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737,
+    32745, 32752, 32757, 32761, 32765, 32766, 32767,
+};
+
+/*!
+    @brief  Looks up sin(2 * PI * i / 1024) in Q15
+    @param i Angle index, any value (wraps at 1024)
+    @returns Sine in Q15
+*/
+static int16_t sin1024(uint16_t i) {
+  i &= 1023;
+  if (i <= 256) {
+    return (int16_t)pgm_read_word(&sine_table[i]);
+  } else if (i <= 512) {
+    return (int16_t)pgm_read_word(&sine_table[512 - i]);
+  } else if (i <= 768) {
+    return -(int16_t)pgm_read_word(&sine_table[i - 512]);
+  }
+  return -(int16_t)pgm_read_word(&sine_table[1024 - i]);
+}
+
+/*!
+    @brief  Looks up cos(2 * PI * i / 1024) in Q15
+    @param i Angle index, any value (wraps at 1024)
+    @returns Cosine in Q15
+*/
+static int16_t cos1024(uint16_t i) { return sin1024(i + 256); }
+
+/*!
+    @brief  Saturates a value to the int16_t range
+    @param v The value to clamp
+    @returns v limited to -32768..32767
+*/
+static int16_t clamp16(int32_t v) {
+  if (v > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (v < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return v;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new, unconfigured spectrum analyzer
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_FFT::Adafruit_MMC56x3_FFT(void) {}
+
+/**************************************************************************/
+/*!
+    @brief  Hands the analyzer its memory and settings
+    @param size FFT length, a power of two from 8 to MMC56X3_FFT_MAX_SIZE
+    @param capture Buffer of `size` samples that addSample() fills
+    @param real Buffer of `size` values the transform works in
+    @param imag Buffer of `size` values the transform works in
+    @param power Buffer of `size / 2` averaged bin powers, or `size` when
+    averages is more than 1: the upper half then holds the average being
+    built, so the lower half keeps the last completed one
+    @param averages Number of blocks averaged into each spectrum
+    @param hann True to apply a Hann window, false for rectangular
+    @returns True if the parameters are usable
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_FFT::begin(uint16_t size, int16_t *capture,
+                                 int16_t *real, int16_t *imag, uint32_t *power,
+                                 uint8_t averages, bool hann) {
+  if ((size < 8) || (size > MMC56X3_FFT_MAX_SIZE) || (size & (size - 1)) ||
+      !capture || !real || !imag || !power || (averages == 0)) {
+    return false;
+  }
+
+  _size = size;
+  _log2_size = 0;
+  while ((1U << _log2_size) < size) {
+    _log2_size++;
+  }
+
+  _capture = capture;
+  _real = real;
+  _imag = imag;
+  _power = power;
+  _averages = averages;
+  _hann = hann;
+
+  _captured = 0;
+  _capture_sum = 0;
+  _skipped = 0;
+  _averaged = 0;
+  _busy = false;
+  _accum = (averages > 1) ? power + size / 2 : power;
+  memset(_power, 0, sizeof(uint32_t) * (size / 2));
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds one sample to the capture block. Cheap enough to call
+    straight from the acquisition loop.
+    @param value Raw counts for the axis (or projection) being analyzed,
+    saturated to 16 bits
+    @returns True if stored, false if skipped because the previous full
+    block is still waiting for process() to pick it up
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_FFT::addSample(int32_t value) {
+  if (!_capture) {
+    return false;
+  }
+  if (_captured >= _size) {
+    _skipped++;
+    return false;
+  }
+  int16_t v = clamp16(value);
+  _capture[_captured++] = v;
+  _capture_sum += v;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Advances the spectrum computation by one small step: handing a
+    full capture block over to the transform, or one radix-2 stage of
+    size / 2 butterflies. Call it regularly, e.g. once per loop().
+    @returns True when a new averaged spectrum has been completed
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_FFT::process(void) {
+  if (!_busy) {
+    if ((_size == 0) || (_captured < _size)) {
+      return false;
+    }
+    loadBlock();
+    _busy = true;
+    _stage = 0;
+    return false;
+  }
+
+  transformStage();
+  if (++_stage < _log2_size) {
+    return false;
+  }
+
+  accumulatePower();
+  _busy = false;
+  if (++_averaged < _averages) {
+    return false;
+  }
+  _averaged = 0;
+  if (_accum != _power) {
+    memcpy(_power, _accum, sizeof(uint32_t) * (_size / 2));
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the averaged power of a bin from the last completed
+    spectrum. Power is re^2 + im^2 after the 1/N scaling of the transform,
+    so a full scale sine lands around (amplitude / 4)^2 with the Hann window
+    and (amplitude / 2)^2 without.
+    @param bin Bin index, 0 to getNumBins() - 1
+    @returns Power in squared counts
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC56x3_FFT::getPower(uint16_t bin) {
+  if (bin >= _size / 2) {
+    return 0;
+  }
+  return _power[bin];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the center frequency of a bin
+    @param bin Bin index, 0 to getNumBins() - 1
+    @param sample_rate Rate samples were added at, in Hz
+    @returns Frequency in Hz
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_FFT::getBinFrequency(uint16_t bin, float sample_rate) {
+  if (_size == 0) {
+    return NAN;
+  }
+  return bin * sample_rate / _size;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Moves the capture block into the transform buffers, removing
+    its mean, windowing it and storing it in bit-reversed order, then frees
+    the capture buffer for the next block
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FFT::loadBlock(void) {
+  int32_t mean = _capture_sum / _size;
+  uint16_t step = MMC56X3_FFT_MAX_SIZE / _size;
+
+  for (uint16_t n = 0; n < _size; n++) {
+    int32_t v = _capture[n] - mean;
+    if (_hann) {
+      // 0.5 - 0.5 * cos(2 * PI * n / N), in Q15
+      int32_t w = (32767L - cos1024(n * step)) >> 1;
+      v = (v * w) >> 15;
+    }
+
+    uint16_t r = 0;
+    for (uint8_t b = 0; b < _log2_size; b++) {
+      r |= ((n >> b) & 1) << (_log2_size - 1 - b);
+    }
+    _real[r] = clamp16(v);
+    _imag[r] = 0;
+  }
+
+  _captured = 0;
+  _capture_sum = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Runs one decimation-in-time stage, halving the values each
+    stage so the result never overflows
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FFT::transformStage(void) {
+  uint16_t half = 1 << _stage;
+  uint16_t step = MMC56X3_FFT_MAX_SIZE / (2 * half);
+
+  for (uint16_t k = 0; k < half; k++) {
+    // twiddle e^(-j * 2 * PI * k / (2 * half))
+    int32_t wr = cos1024(k * step);
+    int32_t wi = -sin1024(k * step);
+
+    for (uint16_t i = k; i < _size; i += 2 * half) {
+      uint16_t j = i + half;
+      int32_t tr = (wr * _real[j] - wi * _imag[j]) >> 15;
+      int32_t ti = (wr * _imag[j] + wi * _real[j]) >> 15;
+      int32_t ur = _real[i];
+      int32_t ui = _imag[i];
+
+      _real[j] = (ur - tr) >> 1;
+      _imag[j] = (ui - ti) >> 1;
+      _real[i] = (ur + tr) >> 1;
+      _imag[i] = (ui + ti) >> 1;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Folds the finished block's bin powers into the running mean
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FFT::accumulatePower(void) {
+  int32_t blocks = _averaged + 1;
+
+  for (uint16_t k = 0; k < _size / 2; k++) {
+    uint32_t p = (uint32_t)((int32_t)_real[k] * _real[k]) +
+                 (uint32_t)((int32_t)_imag[k] * _imag[k]);
+    if (blocks == 1) {
+      _accum[k] = p;
+    } else {
+      _accum[k] += ((int64_t)p - _accum[k]) / blocks;
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/*!
+ * @file Adafruit_MMC56x3_FFT.h
+ *
+ * Fixed point spectrum snapshots of the MMC5603's high rate sample stream
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_FFT_H
+#define MMC56X3_FFT_H
+
+#include "Arduino.h"
+
+#define MMC56X3_FFT_MAX_SIZE 1024 //!< Largest supported FFT length
+
+/**************************************************************************/
+/*!
+    @brief  Captures power-of-two blocks of samples into caller provided
+    memory and turns them into an averaged power spectrum with a Q15
+    radix-2 FFT. Capturing (addSample) is cheap and independent of the
+    transform, which process() advances one stage per call so it can be
+    spread across loop() iterations without holding up sensor reads.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_FFT {
+public:
+  Adafruit_MMC56x3_FFT(void);
+
+  bool begin(uint16_t size, int16_t *capture, int16_t *real, int16_t *imag,
+             uint32_t *power, uint8_t averages = 1, bool hann = true);
+
+  bool addSample(int32_t value);
+  bool process(void);
+
+  uint32_t getPower(uint16_t bin);
+  float getBinFrequency(uint16_t bin, float sample_rate);
+
+  /*! @brief Number of usable output bins @returns size / 2 */
+  uint16_t getNumBins(void) { return _size / 2; }
+  /*! @brief Samples not captured because the previous block had not been
+      handed to the transform yet @returns Skipped sample count */
+  uint32_t getSkippedSamples(void) { return _skipped; }
+
+private:
+  void loadBlock(void);
+  void transformStage(void);
+  void accumulatePower(void);
+
+  int16_t *_capture = NULL;
+  int16_t *_real = NULL;
+  int16_t *_imag = NULL;
+  uint32_t *_power = NULL;
+  uint32_t *_accum = NULL; ///< running average, _power or its upper half
+
+  int32_t _capture_sum = 0;
+  uint32_t _skipped = 0;
+  uint16_t _size = 0;
+  uint16_t _captured = 0;
+  uint8_t _log2_size = 0;
+  uint8_t _stage = 0;
+  uint8_t _averages = 1;
+  uint8_t _averaged = 0;
+  bool _hann = true;
+  bool _busy = false;
+};
+
+#endif
@@ -0,0 +1,206 @@
+/*!
+ * @file Adafruit_MMC56x3_FanOut.cpp
+ *
+ * Delivers one MMC5603 sample stream to several consumers, each at its own
+ * decimated rate
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_FanOut.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a fan-out with no consumers
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_FanOut::Adafruit_MMC56x3_FanOut(void) {}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the input rate and removes all consumers
+    @param input_rate Rate update() is called at in Hz, normally the
+    sensor's data rate
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FanOut::begin(float input_rate) {
+  _input_rate = input_rate;
+  _num = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Registers a consumer. The rate is rounded to a whole divisor of
+    the input rate, check the result with getRate(). Restarts all streams.
+    @param rate Wanted output rate in Hz
+    @param filter MMC56X3_FANOUT_DECIMATE or MMC56X3_FANOUT_AVERAGE. The
+    boxcar average is a cheap anti-alias filter, with nulls at multiples of
+    the output rate.
+    @param callback Called with each output, or NULL to poll getLatest()
+    @param context Passed to the callback
+    @returns Consumer number, or -1 if full or the rate is out of range
+*/
+/**************************************************************************/
+int8_t Adafruit_MMC56x3_FanOut::addConsumer(float rate,
+                                            mmc56x3_fanout_filter_t filter,
+                                            mmc56x3_fanout_callback_t callback,
+                                            void *context) {
+  if ((_num >= MMC56X3_FANOUT_MAX_CONSUMERS) || !(rate > 0) ||
+      !(_input_rate > 0)) {
+    return -1;
+  }
+  float factor = roundf(_input_rate / rate);
+  if ((factor < 1) || (factor > MMC56X3_FANOUT_MAX_FACTOR)) {
+    return -1;
+  }
+
+  consumer_t *c = &_consumers[_num];
+  c->callback = callback;
+  c->context = context;
+  c->factor = (uint16_t)factor;
+  c->filter = filter;
+  _num++;
+
+  link();
+  reset();
+  return _num - 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sorts consumers by factor and chains each to the largest
+    factor consumer with the same filter that divides its own
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FanOut::link(void) {
+  for (uint8_t i = 0; i < _num; i++) {
+    uint8_t j = i;
+    while ((j > 0) &&
+           (_consumers[_order[j - 1]].factor > _consumers[i].factor)) {
+      _order[j] = _order[j - 1];
+      j--;
+    }
+    _order[j] = i;
+  }
+
+  for (uint8_t i = 0; i < _num; i++) {
+    consumer_t *c = &_consumers[_order[i]];
+    c->parent = -1;
+    c->step = c->factor;
+    for (uint8_t j = 0; j < i; j++) {
+      consumer_t *p = &_consumers[_order[j]];
+      if ((p->filter == c->filter) && (c->factor % p->factor == 0)) {
+        c->parent = _order[j]; // later candidates have larger factors
+        c->step = c->factor / p->factor;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Restarts every consumer's block, so all streams are aligned to
+    the next input sample
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FanOut::reset(void) {
+  for (uint8_t i = 0; i < _num; i++) {
+    consumer_t *c = &_consumers[i];
+    memset(c->sum, 0, sizeof(c->sum));
+    c->count = 0;
+    c->fired = false;
+    c->valid = false;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Feeds in one input sample and runs the callbacks of any
+    consumers that produce an output on it
+    @param raw The x, y and z raw counts, e.g. from readRaw()
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FanOut::update(const int32_t raw[3]) {
+  for (uint8_t i = 0; i < _num; i++) {
+    consumer_t *c = &_consumers[_order[i]];
+    const int32_t *in = raw;
+    c->fired = false;
+
+    // parents come first in _order, so their result for this sample is in
+    if (c->parent >= 0) {
+      consumer_t *p = &_consumers[c->parent];
+      if (!p->fired) {
+        continue;
+      }
+      in = p->done;
+    }
+
+    if (c->filter == MMC56X3_FANOUT_AVERAGE) {
+      for (uint8_t a = 0; a < 3; a++) {
+        c->sum[a] += in[a];
+      }
+    }
+    if (++c->count < c->step) {
+      continue;
+    }
+
+    c->count = 0;
+    c->fired = true;
+    c->valid = true;
+    if (c->filter == MMC56X3_FANOUT_AVERAGE) {
+      memcpy(c->done, c->sum, sizeof(c->done));
+      memset(c->sum, 0, sizeof(c->sum));
+    } else {
+      memcpy(c->done, in, sizeof(c->done));
+    }
+
+    if (c->callback) {
+      int32_t out[3];
+      getLatest(_order[i], out);
+      c->callback(out, c->context);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets a consumer's actual output rate
+    @param consumer Number returned by addConsumer()
+    @returns Output rate in Hz, or NAN for an unknown consumer
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_FanOut::getRate(uint8_t consumer) {
+  if (consumer >= _num) {
+    return NAN;
+  }
+  return _input_rate / _consumers[consumer].factor;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets a consumer's most recent output
+    @param consumer Number returned by addConsumer()
+    @param out Filled with the x, y and z output in raw counts
+    @returns True if the consumer has produced an output yet
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_FanOut::getLatest(uint8_t consumer, int32_t out[3]) {
+  if ((consumer >= _num) || !_consumers[consumer].valid) {
+    return false;
+  }
+  consumer_t *c = &_consumers[consumer];
+  for (uint8_t a = 0; a < 3; a++) {
+    if (c->filter == MMC56X3_FANOUT_AVERAGE) {
+      // round to nearest, symmetric about zero
+      int32_t half = c->factor / 2;
+      out[a] = (c->done[a] + ((c->done[a] < 0) ? -half : half)) / c->factor;
+    } else {
+      out[a] = c->done[a];
+    }
+  }
+  return true;
+}
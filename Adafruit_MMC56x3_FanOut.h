@@ -0,0 +1,87 @@
+/*!
+ * @file Adafruit_MMC56x3_FanOut.h
+ *
+ * Delivers one MMC5603 sample stream to several consumers, each at its own
+ * decimated rate
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_FANOUT_H
+#define MMC56X3_FANOUT_H
+
+#include "Adafruit_MMC56x3.h"
+
+#ifndef MMC56X3_FANOUT_MAX_CONSUMERS
+#define MMC56X3_FANOUT_MAX_CONSUMERS 4 //!< Consumers per fan-out
+#endif
+
+#define MMC56X3_FANOUT_MAX_FACTOR 2048 //!< Largest decimation factor
+
+/*!
+ * @brief How a consumer's stream is reduced to its rate
+ */
+typedef enum {
+  MMC56X3_FANOUT_DECIMATE, ///< keep every Nth sample, no filtering
+  MMC56X3_FANOUT_AVERAGE,  ///< mean of each block of N samples (boxcar)
+} mmc56x3_fanout_filter_t;
+
+/*!
+ * @brief Called with each output sample of a consumer, in raw counts
+ */
+typedef void (*mmc56x3_fanout_callback_t)(const int32_t out[3],
+                                          void *context);
+
+/**************************************************************************/
+/*!
+    @brief  Reduces a single acquisition to each consumer's rate in one
+    pass. Consumers using the same filter are chained where their factors
+    divide evenly, so a 100x average is built from ten 10x block sums
+    rather than from the 100 input samples again, and a decimator only
+    counts its parent's outputs.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_FanOut {
+public:
+  Adafruit_MMC56x3_FanOut(void);
+
+  void begin(float input_rate);
+  int8_t addConsumer(float rate, mmc56x3_fanout_filter_t filter,
+                     mmc56x3_fanout_callback_t callback,
+                     void *context = NULL);
+  void reset(void);
+
+  void update(const int32_t raw[3]);
+
+  float getRate(uint8_t consumer);
+  bool getLatest(uint8_t consumer, int32_t out[3]);
+
+private:
+  void link(void);
+
+  /*! @brief One registered consumer */
+  typedef struct {
+    mmc56x3_fanout_callback_t callback; ///< output callback
+    void *context;                      ///< passed to the callback
+    int32_t sum[3];                     ///< running block sum
+    int32_t done[3];                    ///< last complete sum (or sample)
+    uint16_t factor;                    ///< input samples per output
+    uint16_t step;                      ///< parent outputs per output
+    uint16_t count;                     ///< parent outputs so far
+    int8_t parent;                      ///< chained consumer, or -1
+    uint8_t filter;                     ///< mmc56x3_fanout_filter_t
+    bool fired;                         ///< output on this update
+    bool valid;                         ///< an output has been produced
+  } consumer_t;
+
+  consumer_t _consumers[MMC56X3_FANOUT_MAX_CONSUMERS];
+  uint8_t _order[MMC56X3_FANOUT_MAX_CONSUMERS]; ///< ascending factor
+  uint8_t _num = 0;
+  float _input_rate = 0;
+};
+
+#endif
@@ -0,0 +1,140 @@
+/*!
+ * @file Adafruit_MMC56x3_FieldCheck.cpp
+ *
+ * Per-sample quality check of calibrated readings against the expected
+ * earth field magnitude and inclination
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_FieldCheck.h"
+#include "Adafruit_MMC56x3.h"
+#include "Adafruit_MMC56x3_Math.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new check, accepting anything in the 25-65 uT
+    range of the earth's field, with no inclination test
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_FieldCheck::Adafruit_MMC56x3_FieldCheck(void) {
+  updateBands();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the field expected at this location, e.g. from
+    Adafruit_MMC56x3_WMM
+    @param total Expected total intensity in uT
+    @param inclination Expected inclination in degrees (positive down), or
+    NAN to skip the inclination test
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FieldCheck::setExpected(float total, float inclination) {
+  _total = total;
+  _incl = inclination;
+  updateBands();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets how far a reading may be from the expected field before it
+    is flagged
+    @param total Allowed magnitude error in uT
+    @param inclination Allowed inclination error in degrees
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FieldCheck::setTolerance(float total,
+                                               float inclination) {
+  _total_tol = total;
+  _incl_tol = inclination;
+  updateBands();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Checks one calibrated sample
+    @param raw Hard iron corrected x, y and z raw counts
+    @param gravity Optional accelerometer reading in the same axes as the
+    magnetometer (any unit, pointing up when at rest) to enable the
+    inclination test
+    @returns MMC56X3_FIELD_OK, or a combination of MMC56X3_FIELD_LOW,
+    MMC56X3_FIELD_HIGH and MMC56X3_FIELD_INCLINATION
+*/
+/**************************************************************************/
+uint8_t Adafruit_MMC56x3_FieldCheck::check(const int32_t raw[3],
+                                           const float gravity[3]) {
+  uint8_t flags = MMC56X3_FIELD_OK;
+
+  uint64_t mag_sq = 0;
+  for (uint8_t a = 0; a < 3; a++) {
+    mag_sq += (uint64_t)((int64_t)raw[a] * raw[a]);
+  }
+  if (mag_sq < _min_sq) {
+    flags |= MMC56X3_FIELD_LOW;
+  } else if (mag_sq > _max_sq) {
+    flags |= MMC56X3_FIELD_HIGH;
+  }
+
+  _magnitude = mmc56x3_isqrt64(mag_sq);
+  uint32_t err = (_magnitude > _expected) ? (_magnitude - _expected)
+                                          : (_expected - _magnitude);
+  _quality = (err >= _tol) ? 0 : 255 - (uint32_t)(err * 255 / _tol);
+
+  if (gravity && !isnan(_incl) && (_magnitude > 0)) {
+    float g2 = gravity[0] * gravity[0] + gravity[1] * gravity[1] +
+               gravity[2] * gravity[2];
+    if (g2 > 0) {
+      // gravity points up, so the dip below horizontal is -m.g / |m||g|
+      float dot = raw[0] * gravity[0] + raw[1] * gravity[1] +
+                  raw[2] * gravity[2];
+      float sin_incl = -dot / (_magnitude * sqrtf(g2));
+      if ((sin_incl < _sin_incl_lo) || (sin_incl > _sin_incl_hi)) {
+        flags |= MMC56X3_FIELD_INCLINATION;
+        _quality = 0;
+      }
+    }
+  }
+
+  return flags;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the field magnitude of the last checked sample
+    @returns Magnitude in uT
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_FieldCheck::getMagnitude(void) {
+  return _magnitude * MMC56X3_LSB_UT;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Converts the expected field and tolerances into the integer
+    thresholds check() compares against
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_FieldCheck::updateBands(void) {
+  float lo = (_total - _total_tol) / MMC56X3_LSB_UT;
+  float hi = (_total + _total_tol) / MMC56X3_LSB_UT;
+  if (lo < 0) {
+    lo = 0;
+  }
+  _min_sq = (uint64_t)lo * (uint64_t)lo;
+  _max_sq = (uint64_t)hi * (uint64_t)hi;
+  _expected = _total / MMC56X3_LSB_UT;
+  _tol = _total_tol / MMC56X3_LSB_UT;
+  if (_tol == 0) {
+    _tol = 1;
+  }
+
+  float incl_lo = _incl - _incl_tol;
+  float incl_hi = _incl + _incl_tol;
+  _sin_incl_lo = (incl_lo <= -90) ? -1 : sinf(incl_lo * DEG_TO_RAD);
+  _sin_incl_hi = (incl_hi >= 90) ? 1 : sinf(incl_hi * DEG_TO_RAD);
+}
@@ -0,0 +1,63 @@
+/*!
+ * @file Adafruit_MMC56x3_FieldCheck.h
+ *
+ * Per-sample quality check of calibrated readings against the expected
+ * earth field magnitude and inclination
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_FIELDCHECK_H
+#define MMC56X3_FIELDCHECK_H
+
+#include "Arduino.h"
+
+#define MMC56X3_FIELD_OK 0x00          //!< Reading matches the earth field
+#define MMC56X3_FIELD_LOW 0x01         //!< Magnitude below the allowed band
+#define MMC56X3_FIELD_HIGH 0x02        //!< Magnitude above the allowed band
+#define MMC56X3_FIELD_INCLINATION 0x04 //!< Dip angle outside the allowed band
+
+/**************************************************************************/
+/*!
+    @brief  Flags disturbed magnetometer readings. The magnitude test works
+    on raw counts with integer math only (an integer square root for the
+    quality score), and the optional inclination test compares sines so no
+    trig is needed per sample.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_FieldCheck {
+public:
+  Adafruit_MMC56x3_FieldCheck(void);
+
+  void setExpected(float total, float inclination = NAN);
+  void setTolerance(float total, float inclination = 10);
+
+  uint8_t check(const int32_t raw[3], const float gravity[3] = NULL);
+
+  /*! @brief Quality of the last checked sample
+      @returns 255 for a perfect match, falling to 0 at the tolerance */
+  uint8_t getQuality(void) { return _quality; }
+  float getMagnitude(void);
+
+private:
+  void updateBands(void);
+
+  float _total = 45;       ///< expected magnitude, uT
+  float _total_tol = 20;   ///< allowed magnitude error, uT
+  float _incl = NAN;       ///< expected inclination, degrees
+  float _incl_tol = 10;    ///< allowed inclination error, degrees
+  float _sin_incl_lo = -1; ///< sine of the lowest allowed inclination
+  float _sin_incl_hi = 1;  ///< sine of the highest allowed inclination
+  uint64_t _min_sq = 0;    ///< lowest allowed magnitude squared, counts
+  uint64_t _max_sq = 0;    ///< highest allowed magnitude squared, counts
+  uint32_t _expected = 0;  ///< expected magnitude, counts
+  uint32_t _tol = 1;       ///< allowed magnitude error, counts
+  uint32_t _magnitude = 0; ///< magnitude of the last sample, counts
+  uint8_t _quality = 0;    ///< quality of the last sample
+};
+
+#endif
@@ -0,0 +1,227 @@
+/*!
+ * @file Adafruit_MMC56x3_Goertzel.cpp
+ *
+ * Streaming Goertzel filter bank for measuring (and optionally cancelling)
+ * tonal interference such as 50/60 Hz mains pickup in MMC5603 samples.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Goertzel.h"
+#include "Adafruit_MMC56x3.h"
+
+#define Q14_ONE 16384 //!< 1.0 in Q14
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new Goertzel bank with no bins
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_Goertzel::Adafruit_MMC56x3_Goertzel(void) {
+  memset(_bins, 0, sizeof(_bins));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets the sample rate and analysis block length, and removes any
+    existing bins. For clean results pick a block length that holds a whole
+    number of cycles of every bin, e.g. 100 samples at 1000 Hz for 50 and
+    60 Hz.
+    @param sample_rate Rate that update() will be called at, in Hz
+    @param block_len Samples per analysis block
+    @returns True if the parameters are usable
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Goertzel::begin(float sample_rate, uint16_t block_len) {
+  if ((sample_rate <= 0) || (block_len < 2)) {
+    return false;
+  }
+  _sample_rate = sample_rate;
+  _block_len = block_len;
+  clearBins();
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds a frequency to track on all three axes
+    @param frequency Frequency in Hz, below half the sample rate
+    @returns The bin index, or -1 if the bank is full or frequency invalid
+*/
+/**************************************************************************/
+int8_t Adafruit_MMC56x3_Goertzel::addBin(float frequency) {
+  if ((_num_bins >= MMC56X3_GOERTZEL_MAX_BINS) || (frequency <= 0) ||
+      (frequency >= _sample_rate / 2)) {
+    return -1;
+  }
+
+  goertzel_bin_t *b = &_bins[_num_bins];
+  memset(b, 0, sizeof(goertzel_bin_t));
+
+  // trig is only evaluated here, the per-sample path is integer only
+  float w = 2 * PI * frequency / _sample_rate;
+  b->freq = frequency;
+  b->cos_w = lround(cosf(w) * Q14_ONE);
+  b->sin_w = lround(sinf(w) * Q14_ONE);
+  b->coeff = 2 * b->cos_w;
+  b->osc_c = Q14_ONE;
+
+  return _num_bins++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Removes all bins
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Goertzel::clearBins(void) {
+  _num_bins = 0;
+  _count = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Restarts the current block and forgets all latched tones
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Goertzel::reset(void) {
+  for (uint8_t i = 0; i < _num_bins; i++) {
+    goertzel_bin_t *b = &_bins[i];
+    memset(b->s1, 0, sizeof(b->s1));
+    memset(b->s2, 0, sizeof(b->s2));
+    memset(b->tone_i, 0, sizeof(b->tone_i));
+    memset(b->tone_q, 0, sizeof(b->tone_q));
+    b->osc_c = Q14_ONE;
+    b->osc_s = 0;
+  }
+  _count = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Feeds one sample through every bin. Work is O(bins) and uses
+    only integer math.
+    @param in The x, y and z raw counts, e.g. from readRaw()
+    @param out Optional array of 3 to receive the input with the tones
+    latched at the end of the previous block subtracted, may alias `in`
+    @returns True when this sample completed a block, so new amplitudes and
+    phases are available
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Goertzel::update(const int32_t in[3], int32_t out[3]) {
+  if (_block_len == 0) {
+    return false;
+  }
+
+  int32_t cancel[3] = {0, 0, 0};
+
+  for (uint8_t i = 0; i < _num_bins; i++) {
+    goertzel_bin_t *b = &_bins[i];
+
+    for (uint8_t a = 0; a < 3; a++) {
+      int32_t s0 =
+          in[a] + (int32_t)(((int64_t)b->coeff * b->s1[a]) >> 14) - b->s2[a];
+      b->s2[a] = b->s1[a];
+      b->s1[a] = s0;
+
+      if (out) {
+        cancel[a] += (int32_t)(((int64_t)b->tone_i[a] * b->osc_c -
+                                (int64_t)b->tone_q[a] * b->osc_s) >>
+                               14);
+      }
+    }
+
+    // rotate the cancellation oscillator on to the next sample
+    int32_t c = b->osc_c * b->cos_w - b->osc_s * b->sin_w;
+    int32_t s = b->osc_c * b->sin_w + b->osc_s * b->cos_w;
+    c = (c + (Q14_ONE / 2)) >> 14;
+    s = (s + (Q14_ONE / 2)) >> 14;
+    b->osc_c = c;
+    b->osc_s = s;
+  }
+
+  if (out) {
+    for (uint8_t a = 0; a < 3; a++) {
+      out[a] = in[a] - cancel[a];
+    }
+  }
+
+  if (++_count < _block_len) {
+    return false;
+  }
+  _count = 0;
+
+  // End of block: y = s[N-1] - e^-jw s[N-2] is the DFT term rotated by
+  // w(N-1). Rotating one more sample and scaling by 2/N gives the tone's
+  // amplitude and phase at the start of the next block.
+  int64_t scale = (int64_t)_block_len << 14;
+  for (uint8_t i = 0; i < _num_bins; i++) {
+    goertzel_bin_t *b = &_bins[i];
+
+    for (uint8_t a = 0; a < 3; a++) {
+      int64_t yr = b->s1[a] - (((int64_t)b->s2[a] * b->cos_w) >> 14);
+      int64_t yi = ((int64_t)b->s2[a] * b->sin_w) >> 14;
+
+      b->tone_i[a] = (int32_t)((2 * (yr * b->cos_w - yi * b->sin_w)) / scale);
+      b->tone_q[a] = (int32_t)((2 * (yr * b->sin_w + yi * b->cos_w)) / scale);
+      b->s1[a] = 0;
+      b->s2[a] = 0;
+    }
+
+    // restart the oscillator at phase 0 so rounding never accumulates
+    b->osc_c = Q14_ONE;
+    b->osc_s = 0;
+  }
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the amplitude of a tone measured over the last full block
+    @param bin The bin index returned by addBin()
+    @param axis 0, 1 or 2 for x, y or z
+    @returns Peak amplitude in uTesla
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_Goertzel::getAmplitude(uint8_t bin, uint8_t axis) {
+  if ((bin >= _num_bins) || (axis > 2)) {
+    return NAN;
+  }
+  float i = _bins[bin].tone_i[axis];
+  float q = _bins[bin].tone_q[axis];
+  return sqrtf(i * i + q * q) * MMC56X3_LSB_UT;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the phase of a tone measured over the last full block
+    @param bin The bin index returned by addBin()
+    @param axis 0, 1 or 2 for x, y or z
+    @returns Phase in radians, referenced to the start of the current block
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_Goertzel::getPhase(uint8_t bin, uint8_t axis) {
+  if ((bin >= _num_bins) || (axis > 2)) {
+    return NAN;
+  }
+  return atan2f(_bins[bin].tone_q[axis], _bins[bin].tone_i[axis]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the frequency a bin was configured for
+    @param bin The bin index returned by addBin()
+    @returns Frequency in Hz
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_Goertzel::getFrequency(uint8_t bin) {
+  if (bin >= _num_bins) {
+    return NAN;
+  }
+  return _bins[bin].freq;
+}
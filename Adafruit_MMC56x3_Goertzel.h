@@ -0,0 +1,71 @@
+/*!
+ * @file Adafruit_MMC56x3_Goertzel.h
+ *
+ * Streaming Goertzel filter bank for measuring (and optionally cancelling)
+ * tonal interference such as 50/60 Hz mains pickup in MMC5603 samples.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_GOERTZEL_H
+#define MMC56X3_GOERTZEL_H
+
+#include "Arduino.h"
+
+#ifndef MMC56X3_GOERTZEL_MAX_BINS
+#define MMC56X3_GOERTZEL_MAX_BINS 4 //!< Max frequencies tracked at once
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Fixed point Goertzel bank that runs on raw MMC5603 counts, one
+    sample at a time. Every block of samples it latches the amplitude and
+    phase of each configured frequency on each axis, and it can subtract the
+    latched tones from the incoming samples (a notch / canceller).
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Goertzel {
+public:
+  Adafruit_MMC56x3_Goertzel(void);
+
+  bool begin(float sample_rate, uint16_t block_len = 100);
+  int8_t addBin(float frequency);
+  void clearBins(void);
+  void reset(void);
+
+  bool update(const int32_t in[3], int32_t out[3] = NULL);
+
+  float getAmplitude(uint8_t bin, uint8_t axis);
+  float getPhase(uint8_t bin, uint8_t axis);
+  float getFrequency(uint8_t bin);
+
+  /*! @brief Number of configured frequency bins @returns Bin count */
+  uint8_t getNumBins(void) { return _num_bins; }
+
+private:
+  /*! @brief Per-frequency state, trig terms are Q14 fixed point */
+  typedef struct {
+    float freq;        ///< Bin frequency in Hz
+    int32_t coeff;     ///< 2*cos(w)
+    int32_t cos_w;     ///< cos(w)
+    int32_t sin_w;     ///< sin(w)
+    int32_t osc_c;     ///< cancellation oscillator, cos(w*n)
+    int32_t osc_s;     ///< cancellation oscillator, sin(w*n)
+    int32_t s1[3];     ///< Goertzel state s[n-1] per axis
+    int32_t s2[3];     ///< Goertzel state s[n-2] per axis
+    int32_t tone_i[3]; ///< latched tone at block start, in-phase counts
+    int32_t tone_q[3]; ///< latched tone at block start, quadrature counts
+  } goertzel_bin_t;
+
+  goertzel_bin_t _bins[MMC56X3_GOERTZEL_MAX_BINS];
+  uint8_t _num_bins = 0;
+  float _sample_rate = 0;
+  uint16_t _block_len = 0;
+  uint16_t _count = 0;
+};
+
+#endif
@@ -0,0 +1,143 @@
+/*!
+ * @file Adafruit_MMC56x3_Heading.cpp
+ *
+ * Wrap-safe heading smoothing with hysteresis based heading change events
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Heading.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new heading smoother
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_Heading::Adafruit_MMC56x3_Heading(void) {}
+
+/**************************************************************************/
+/*!
+    @brief  Sets up the smoother
+    @param sample_rate How often update() will be called, in Hz
+    @param time_constant Smoothing time constant in seconds, 0 for none
+    @param hysteresis Minimum heading change in degrees (up to 90) before
+    update() reports an event
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Heading::begin(float sample_rate, float time_constant,
+                                     float hysteresis) {
+  _sample_rate = sample_rate;
+  setTimeConstant(time_constant);
+  setHysteresis(hysteresis);
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Forgets the smoothed heading and the last reported one, the
+    next sample starts afresh and reports an event
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Heading::reset(void) {
+  _primed = false;
+  // a zero reference is never within the band, so the next sample fires
+  _ref_x = 0;
+  _ref_y = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Changes the smoothing time constant
+    @param time_constant Time constant in seconds, 0 for no smoothing
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Heading::setTimeConstant(float time_constant) {
+  if (time_constant <= 0) {
+    _alpha = 1;
+  } else {
+    _alpha = 1 - expf(-1.0f / (time_constant * _sample_rate));
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Changes the heading change needed to report an event
+    @param hysteresis Angle in degrees, from 0 to 90
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Heading::setHysteresis(float hysteresis) {
+  if (hysteresis < 0) {
+    hysteresis = 0;
+  } else if (hysteresis > 90) {
+    hysteresis = 90;
+  }
+  float c = cosf(hysteresis * DEG_TO_RAD);
+  _cos_hyst2 = c * c;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Feeds in one horizontal field sample, e.g. the x and y of a
+    calibrated getEvent() on a level board
+    @param x Field along the x axis, any unit
+    @param y Field along the y axis, same unit as x
+    @returns True if the smoothed heading has moved more than the
+    hysteresis since the last event (always true for the first sample)
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Heading::update(float x, float y) {
+  if (!_primed) {
+    _mean_x = x;
+    _mean_y = y;
+    _primed = true;
+  } else {
+    _mean_x += _alpha * (x - _mean_x);
+    _mean_y += _alpha * (y - _mean_y);
+  }
+
+  float norm2 = _mean_x * _mean_x + _mean_y * _mean_y;
+  if (norm2 == 0) {
+    return false;
+  }
+
+  // the angle to the reference exceeds the band when
+  // dot < cos(hysteresis) * |mean|, compared squared to skip the sqrt
+  float dot = _mean_x * _ref_x + _mean_y * _ref_y;
+  if ((dot > 0) && (dot * dot >= _cos_hyst2 * norm2)) {
+    return false;
+  }
+
+  float inv = 1 / sqrtf(norm2);
+  _ref_x = _mean_x * inv;
+  _ref_y = _mean_y * inv;
+  _event_heading = getHeading();
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the current smoothed heading, computed on demand
+    @returns Heading in degrees from 0 to 360, matching the compass example
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_Heading::getHeading(void) {
+  float heading = atan2f(_mean_y, _mean_x) * RAD_TO_DEG;
+  if (heading < 0) {
+    heading += 360;
+  }
+  return heading;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the heading as of the last event
+    @returns Heading in degrees from 0 to 360
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_Heading::getEventHeading(void) {
+  return _event_heading;
+}
@@ -0,0 +1,54 @@
+/*!
+ * @file Adafruit_MMC56x3_Heading.h
+ *
+ * Wrap-safe heading smoothing with hysteresis based heading change events
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_HEADING_H
+#define MMC56X3_HEADING_H
+
+#include "Arduino.h"
+
+/**************************************************************************/
+/*!
+    @brief  Smooths compass headings by averaging the horizontal field
+    vector rather than the angle, so there is no jump at the 0/360 wrap.
+    Heading change events are detected with dot products against the last
+    reported direction, so update() needs no trig calls.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Heading {
+public:
+  Adafruit_MMC56x3_Heading(void);
+
+  void begin(float sample_rate, float time_constant = 0.5f,
+             float hysteresis = 2.0f);
+  void reset(void);
+
+  void setTimeConstant(float time_constant);
+  void setHysteresis(float hysteresis);
+
+  bool update(float x, float y);
+
+  float getHeading(void);
+  float getEventHeading(void);
+
+private:
+  float _sample_rate = 10;  ///< update() rate in Hz
+  float _alpha = 1;         ///< exponential smoothing weight per sample
+  float _cos_hyst2 = 1;     ///< cos^2 of the hysteresis angle
+  float _mean_x = 0;        ///< smoothed x field
+  float _mean_y = 0;        ///< smoothed y field
+  float _ref_x = 0;         ///< unit x of the last event, 0 for none
+  float _ref_y = 0;         ///< unit y of the last reported heading
+  float _event_heading = 0; ///< last reported heading, degrees
+  bool _primed = false;     ///< true once the first sample is in
+};
+
+#endif
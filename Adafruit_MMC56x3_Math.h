@@ -0,0 +1,44 @@
+/*!
+ * @file Adafruit_MMC56x3_Math.h
+ *
+ * Small integer math helpers shared by the MMC56x3 processing modules
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_MATH_H
+#define MMC56X3_MATH_H
+
+#include "Arduino.h"
+
+/**************************************************************************/
+/*!
+    @brief  Integer square root, rounded down, by the bitwise method
+    @param v The value to take the root of
+    @returns floor(sqrt(v))
+*/
+/**************************************************************************/
+static inline uint32_t mmc56x3_isqrt64(uint64_t v) {
+  uint64_t root = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+
+  while (bit > v) {
+    bit >>= 2;
+  }
+  while (bit) {
+    if (v >= root + bit) {
+      v -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
+
+#endif
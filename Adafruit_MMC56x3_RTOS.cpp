@@ -0,0 +1,192 @@
+/*!
+ * @file Adafruit_MMC56x3_RTOS.cpp
+ *
+ * FreeRTOS adapter: runs MMC5603 acquisition in its own task, shares the
+ * I2C bus through a mutex and publishes samples to a fixed size queue
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_RTOS.h"
+
+#ifdef MMC56X3_HAS_FREERTOS
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a stopped adapter
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_RTOS::Adafruit_MMC56x3_RTOS(void) {}
+
+/**************************************************************************/
+/*!
+    @brief  Stops the task and frees the queue
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_RTOS::~Adafruit_MMC56x3_RTOS(void) { end(); }
+
+/**************************************************************************/
+/*!
+    @brief  Creates the queue, bus mutex (if none given) and acquisition
+    task. The sensor should already be begin()'d.
+    @param mmc The sensor to sample
+    @param period_ms Milliseconds between samples, rounded to ticks
+    @param bus_lock Mutex shared with other users of the same bus, or NULL
+    to create one (see getBusLock())
+    @param queue_len Samples the queue holds before overflowing
+    @param priority Acquisition task priority
+    @param stack_size Acquisition task stack, in the port's units
+    @returns True if everything was created and the task is running
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_RTOS::begin(Adafruit_MMC5603 *mmc, uint32_t period_ms,
+                                  SemaphoreHandle_t bus_lock,
+                                  uint16_t queue_len, UBaseType_t priority,
+                                  uint32_t stack_size) {
+  end();
+  if (!mmc || (queue_len == 0)) {
+    return false;
+  }
+  _mmc = mmc;
+  _period = pdMS_TO_TICKS(period_ms);
+  if (_period == 0) {
+    _period = 1;
+  }
+
+  _own_lock = (bus_lock == NULL);
+  _bus_lock = _own_lock ? xSemaphoreCreateMutex() : bus_lock;
+  _queue = xQueueCreate(queue_len, sizeof(mmc56x3_sample_t));
+  if (!_bus_lock || !_queue) {
+    end();
+    return false;
+  }
+
+  _samples = _overflows = _errors = 0;
+  if (xTaskCreate(taskEntry, "MMC56x3", stack_size, this, priority, &_task) !=
+      pdPASS) {
+    _task = NULL;
+    end();
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Stops acquisition and frees what begin() created
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_RTOS::end(void) {
+  if (_task) {
+    // wait for any transfer in progress so the bus is never left locked
+    xSemaphoreTake(_bus_lock, portMAX_DELAY);
+    vTaskDelete(_task);
+    _task = NULL;
+    xSemaphoreGive(_bus_lock);
+  }
+  if (_queue) {
+    vQueueDelete(_queue);
+    _queue = NULL;
+  }
+  if (_own_lock && _bus_lock) {
+    vSemaphoreDelete(_bus_lock);
+  }
+  _bus_lock = NULL;
+  _own_lock = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Takes the oldest sample from the queue
+    @param sample Filled with the sample
+    @param wait Ticks to block waiting for one, 0 to poll
+    @returns True if a sample was returned
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_RTOS::read(mmc56x3_sample_t *sample, TickType_t wait) {
+  if (!_queue) {
+    return false;
+  }
+  return xQueueReceive(_queue, sample, wait) == pdTRUE;
+}
+
+/**************************************************************************/
+/*!
+    @brief  FreeRTOS task entry point
+    @param arg The adapter that created the task
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_RTOS::taskEntry(void *arg) {
+  ((Adafruit_MMC56x3_RTOS *)arg)->acquire();
+}
+
+/**************************************************************************/
+/*!
+    @brief  The acquisition loop, paced by the tick timer
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_RTOS::acquire(void) {
+  TickType_t last_wake = xTaskGetTickCount();
+
+  for (;;) {
+    vTaskDelayUntil(&last_wake, _period);
+
+    mmc56x3_sample_t sample;
+    if (!sampleOnce(&sample)) {
+      _errors++;
+      continue;
+    }
+    if (xQueueSend(_queue, &sample, 0) == pdTRUE) {
+      _samples++;
+    } else {
+      _overflows++;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Takes one sample, locking the bus only around each transfer
+    and sleeping through the conversion
+    @param sample Filled with the sample
+    @returns True on success
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_RTOS::sampleOnce(mmc56x3_sample_t *sample) {
+  if (!_mmc->isContinuousMode()) {
+    xSemaphoreTake(_bus_lock, portMAX_DELAY);
+    bool ok = _mmc->startMeasurement();
+    xSemaphoreGive(_bus_lock);
+    if (!ok) {
+      return false;
+    }
+
+    // sleep for the predicted conversion, then check in one tick steps
+    TickType_t wait = pdMS_TO_TICKS((_mmc->getMeasurementTime() + 999) / 1000);
+    vTaskDelay(wait ? wait : 1);
+    for (uint8_t tries = 0;; tries++) {
+      xSemaphoreTake(_bus_lock, portMAX_DELAY);
+      bool ready = _mmc->isDataReady();
+      xSemaphoreGive(_bus_lock);
+      if (ready) {
+        break;
+      }
+      if (tries >= 10) {
+        return false;
+      }
+      vTaskDelay(1);
+    }
+  }
+
+  xSemaphoreTake(_bus_lock, portMAX_DELAY);
+  bool ok = _mmc->readMeasurement(sample->raw);
+  xSemaphoreGive(_bus_lock);
+  sample->timestamp = micros();
+  return ok;
+}
+
+#endif // MMC56X3_HAS_FREERTOS
@@ -0,0 +1,84 @@
+/*!
+ * @file Adafruit_MMC56x3_RTOS.h
+ *
+ * FreeRTOS adapter: runs MMC5603 acquisition in its own task, shares the
+ * I2C bus through a mutex and publishes samples to a fixed size queue
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_RTOS_H
+#define MMC56X3_RTOS_H
+
+#include "Adafruit_MMC56x3.h"
+
+#if defined(ESP32)
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#define MMC56X3_HAS_FREERTOS //!< FreeRTOS is part of this core
+#elif defined(ARDUINO_NRF52_ADAFRUIT)
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+#include <task.h>
+#define MMC56X3_HAS_FREERTOS //!< FreeRTOS is part of this core
+#endif
+
+#ifdef MMC56X3_HAS_FREERTOS
+
+/**************************************************************************/
+/*!
+    @brief  Samples an MMC5603 from a dedicated FreeRTOS task. The task
+    sleeps on the tick timer between samples and through the conversion
+    rather than spinning, holds the bus mutex only around each transfer,
+    and posts timestamped samples to a queue, counting any that do not fit.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_RTOS {
+public:
+  Adafruit_MMC56x3_RTOS(void);
+  ~Adafruit_MMC56x3_RTOS(void);
+
+  bool begin(Adafruit_MMC5603 *mmc, uint32_t period_ms,
+             SemaphoreHandle_t bus_lock = NULL, uint16_t queue_len = 16,
+             UBaseType_t priority = 1, uint32_t stack_size = 2048);
+  void end(void);
+
+  bool read(mmc56x3_sample_t *sample, TickType_t wait = portMAX_DELAY);
+
+  /*! @brief Mutex guarding the bus, take it around any other transfers on
+      the same TwoWire @returns The mutex handle */
+  SemaphoreHandle_t getBusLock(void) { return _bus_lock; }
+  /*! @brief Samples successfully queued @returns Sample count */
+  uint32_t getSamples(void) { return _samples; }
+  /*! @brief Samples dropped because the queue was full
+      @returns Overflow count */
+  uint32_t getOverflows(void) { return _overflows; }
+  /*! @brief Samples lost to bus errors @returns Error count */
+  uint32_t getErrors(void) { return _errors; }
+
+private:
+  static void taskEntry(void *arg);
+  void acquire(void);
+  bool sampleOnce(mmc56x3_sample_t *sample);
+
+  Adafruit_MMC5603 *_mmc = NULL;
+  TaskHandle_t _task = NULL;
+  QueueHandle_t _queue = NULL;
+  SemaphoreHandle_t _bus_lock = NULL;
+  TickType_t _period = 1;
+  bool _own_lock = false;
+  volatile uint32_t _samples = 0;
+  volatile uint32_t _overflows = 0;
+  volatile uint32_t _errors = 0;
+};
+
+#endif // MMC56X3_HAS_FREERTOS
+
+#endif
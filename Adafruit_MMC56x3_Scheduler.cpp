@@ -0,0 +1,272 @@
+/*!
+ * @file Adafruit_MMC56x3_Scheduler.cpp
+ *
+ * Cooperative deadline scheduler sharing one bus between several MMC5603
+ * sensors and other I2C clients, each at its own rate
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Scheduler.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates an empty scheduler
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_Scheduler::Adafruit_MMC56x3_Scheduler(void) {
+  memset(_tasks, 0, sizeof(_tasks));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds a sensor to sample periodically. It should already be
+    begin()'d, and may be in one-shot or continuous mode.
+    @param mmc The sensor
+    @param period_us Microseconds between samples
+    @param callback Called with each sample
+    @param context Passed through to the callback
+    @returns Task index, or -1 if the scheduler is full
+*/
+/**************************************************************************/
+int8_t Adafruit_MMC56x3_Scheduler::addSensor(Adafruit_MMC5603 *mmc,
+                                             uint32_t period_us,
+                                             mmc56x3_sample_callback_t callback,
+                                             void *context) {
+  if (!mmc || (period_us == 0) || (_num_tasks >= MMC56X3_SCHED_MAX_TASKS)) {
+    return -1;
+  }
+  task_t *t = &_tasks[_num_tasks];
+  memset(t, 0, sizeof(task_t));
+  t->mmc = mmc;
+  t->on_sample = callback;
+  t->context = context;
+  t->period = period_us;
+  t->state = TASK_IDLE;
+  return _num_tasks++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adds another bus client to run periodically in between sensor
+    steps
+    @param period_us Microseconds between runs
+    @param callback Does one short bus transaction
+    @param context Passed through to the callback
+    @returns Task index, or -1 if the scheduler is full
+*/
+/**************************************************************************/
+int8_t Adafruit_MMC56x3_Scheduler::addClient(uint32_t period_us,
+                                             mmc56x3_client_callback_t callback,
+                                             void *context) {
+  if (!callback || (period_us == 0) ||
+      (_num_tasks >= MMC56X3_SCHED_MAX_TASKS)) {
+    return -1;
+  }
+  task_t *t = &_tasks[_num_tasks];
+  memset(t, 0, sizeof(task_t));
+  t->on_run = callback;
+  t->context = context;
+  t->period = period_us;
+  t->state = TASK_IDLE;
+  return _num_tasks++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Releases every task now and clears statistics. Call once after
+    adding tasks, before the first run().
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Scheduler::start(void) {
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < _num_tasks; i++) {
+    _tasks[i].release = now;
+    _tasks[i].due = now;
+    _tasks[i].state = TASK_IDLE;
+  }
+  clearStats();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Does the most urgent pending step, if any is due: at most one
+    bus transaction. Call as often as possible, e.g. every loop().
+    @returns True if a step was run
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Scheduler::run(void) {
+  uint32_t now = micros();
+  task_t *next = NULL;
+  int32_t best_slack = 0;
+
+  // earliest deadline first, among tasks whose next step is due
+  for (uint8_t i = 0; i < _num_tasks; i++) {
+    task_t *t = &_tasks[i];
+    if ((int32_t)(now - t->due) < 0) {
+      continue;
+    }
+    int32_t slack = (int32_t)(t->release + t->period - now);
+    if (!next || (slack < best_slack)) {
+      next = t;
+      best_slack = slack;
+    }
+  }
+
+  if (!next) {
+    return false;
+  }
+  step(next, now);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Runs one step of a task's measurement cycle
+    @param t The task
+    @param now Current micros()
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Scheduler::step(task_t *t, uint32_t now) {
+  switch (t->state) {
+  case TASK_IDLE: {
+    uint32_t late = now - t->release;
+    if (late > t->max_late) {
+      t->max_late = late;
+    }
+    if (!t->mmc) {
+      t->on_run(t->context);
+      finish(t, now, true);
+    } else if (t->mmc->isContinuousMode()) {
+      // data is always there, go straight to the read
+      t->state = TASK_READY;
+      step(t, now);
+    } else {
+      uint32_t wait = t->mmc->getMeasurementTime();
+      t->mmc->startMeasurement();
+      t->state = TASK_CONVERTING;
+      t->due = now + wait;
+      // a sensor that never reports ready must not hold bus slots forever
+      t->deadline = now + 2 * wait + 1000;
+    }
+    break;
+  }
+
+  case TASK_CONVERTING:
+    if (t->mmc->isDataReady()) {
+      t->state = TASK_READY;
+      t->due = now;
+    } else if ((int32_t)(now - t->deadline) >= 0) {
+      finish(t, now, false);
+    } else {
+      t->due = now + MMC56X3_SCHED_POLL_US;
+    }
+    break;
+
+  case TASK_READY: {
+    mmc56x3_sample_t sample;
+    bool ok = t->mmc->readMeasurement(sample.raw);
+    if (ok) {
+      sample.timestamp = micros();
+      if (t->on_sample) {
+        t->on_sample(t->mmc, &sample, t->context);
+      }
+    }
+    finish(t, now, ok);
+    break;
+  }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Completes a task's cycle and schedules its next release,
+    skipping releases it has fallen a whole period behind on
+    @param t The task
+    @param now Current micros()
+    @param ok True if the cycle produced a sample, false if the conversion
+    timed out or the read failed
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Scheduler::finish(task_t *t, uint32_t now, bool ok) {
+  if (ok) {
+    t->samples++;
+  } else {
+    t->errors++;
+  }
+  t->state = TASK_IDLE;
+  t->release += t->period;
+  while ((int32_t)(now - t->release) >= (int32_t)t->period) {
+    t->release += t->period;
+    t->overruns++;
+  }
+  t->due = t->release;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets how many samples (or client runs) a task has completed
+    successfully
+    @param task Index from addSensor() or addClient()
+    @returns Completed count since start() or clearStats()
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC56x3_Scheduler::getSamples(uint8_t task) {
+  return (task < _num_tasks) ? _tasks[task].samples : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the worst delay between a task's release and when its
+    first step actually ran, i.e. its start jitter
+    @param task Index from addSensor() or addClient()
+    @returns Lateness in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC56x3_Scheduler::getMaxLateness(uint8_t task) {
+  return (task < _num_tasks) ? _tasks[task].max_late : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets how many releases a task skipped because it fell more than
+    a period behind, a sign the bus is oversubscribed
+    @param task Index from addSensor() or addClient()
+    @returns Skipped release count
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC56x3_Scheduler::getOverruns(uint8_t task) {
+  return (task < _num_tasks) ? _tasks[task].overruns : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets how many of a sensor's cycles produced no sample, because
+    the conversion never reported ready within twice its expected time
+    plus a millisecond, or the data read failed
+    @param task Index from addSensor()
+    @returns Failed cycle count
+*/
+/**************************************************************************/
+uint32_t Adafruit_MMC56x3_Scheduler::getErrors(uint8_t task) {
+  return (task < _num_tasks) ? _tasks[task].errors : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Resets all sample counts, lateness, overrun and error
+    statistics
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Scheduler::clearStats(void) {
+  for (uint8_t i = 0; i < _num_tasks; i++) {
+    _tasks[i].samples = 0;
+    _tasks[i].errors = 0;
+    _tasks[i].max_late = 0;
+    _tasks[i].overruns = 0;
+  }
+}
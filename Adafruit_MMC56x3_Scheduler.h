@@ -0,0 +1,97 @@
+/*!
+ * @file Adafruit_MMC56x3_Scheduler.h
+ *
+ * Cooperative deadline scheduler sharing one bus between several MMC5603
+ * sensors and other I2C clients, each at its own rate
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_SCHEDULER_H
+#define MMC56X3_SCHEDULER_H
+
+#include "Adafruit_MMC56x3.h"
+
+#ifndef MMC56X3_SCHED_MAX_TASKS
+#define MMC56X3_SCHED_MAX_TASKS 8 //!< Sensors plus clients per scheduler
+#endif
+
+#define MMC56X3_SCHED_POLL_US 500 //!< Status re-check interval, us
+
+/*!
+ * @brief Called with each new sample from a scheduled sensor
+ */
+typedef void (*mmc56x3_sample_callback_t)(Adafruit_MMC5603 *mmc,
+                                          const mmc56x3_sample_t *sample,
+                                          void *context);
+
+/*!
+ * @brief Called when a scheduled bus client is due, it should do one short
+ * bus transaction and return
+ */
+typedef void (*mmc56x3_client_callback_t)(void *context);
+
+/**************************************************************************/
+/*!
+    @brief  Interleaves the non-blocking steps of MMC5603 measurements
+    (trigger, status check, data read) for several sensors with other bus
+    clients. Every run() does at most one bus transaction, picked earliest
+    deadline first, so no client holds the bus for longer than one
+    transfer and a sensor's conversion time is free for others to use.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Scheduler {
+public:
+  Adafruit_MMC56x3_Scheduler(void);
+
+  int8_t addSensor(Adafruit_MMC5603 *mmc, uint32_t period_us,
+                   mmc56x3_sample_callback_t callback, void *context = NULL);
+  int8_t addClient(uint32_t period_us, mmc56x3_client_callback_t callback,
+                   void *context = NULL);
+
+  void start(void);
+  bool run(void);
+
+  uint32_t getSamples(uint8_t task);
+  uint32_t getMaxLateness(uint8_t task);
+  uint32_t getOverruns(uint8_t task);
+  uint32_t getErrors(uint8_t task);
+  void clearStats(void);
+
+private:
+  /*! @brief What a task is waiting to do next */
+  typedef enum {
+    TASK_IDLE,       ///< waiting for its next release
+    TASK_CONVERTING, ///< measurement triggered, check status when due
+    TASK_READY,      ///< conversion done, read the data when due
+  } task_state_t;
+
+  /*! @brief One scheduled sensor or client */
+  typedef struct {
+    Adafruit_MMC5603 *mmc;               ///< sensor, or NULL for a client
+    mmc56x3_sample_callback_t on_sample; ///< sensor sample callback
+    mmc56x3_client_callback_t on_run;    ///< client callback
+    void *context;                       ///< passed to the callback
+    uint32_t period;                     ///< us between releases
+    uint32_t release;                    ///< micros() of the current release
+    uint32_t due;                        ///< micros() the next step may run
+    uint32_t deadline;                   ///< micros() to give up converting
+    uint32_t samples;                    ///< completed samples or runs
+    uint32_t errors;                     ///< timed out or failed samples
+    uint32_t max_late;                   ///< worst start delay, us
+    uint32_t overruns;                   ///< releases skipped entirely
+    task_state_t state;                  ///< next step
+  } task_t;
+
+  void step(task_t *t, uint32_t now);
+  void finish(task_t *t, uint32_t now, bool ok);
+
+  task_t _tasks[MMC56X3_SCHED_MAX_TASKS];
+  uint8_t _num_tasks = 0;
+};
+
+#endif
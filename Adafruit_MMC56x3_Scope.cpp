@@ -0,0 +1,227 @@
+/*!
+ * @file Adafruit_MMC56x3_Scope.cpp
+ *
+ * Triggered captures of the MMC5603 sample stream with pre-trigger
+ * history, like an oscilloscope's single shot mode
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Scope.h"
+#include "Adafruit_MMC56x3_Math.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new scope with no memory, call begin() next
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_Scope::Adafruit_MMC56x3_Scope(void) {}
+
+/**************************************************************************/
+/*!
+    @brief  Hands the scope its memory and sets the capture shape. Any
+    capture in progress or waiting to be read is dropped.
+    @param buffers Room for 2 * length samples, used as two buffers
+    @param length Samples per capture
+    @param pre_trigger How many of those come before the trigger sample,
+    less than length. The rest are the trigger sample and what follows it.
+    @returns True if the parameters are usable
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Scope::begin(mmc56x3_sample_t *buffers, uint16_t length,
+                                   uint16_t pre_trigger) {
+  if (!buffers || (length == 0) || (pre_trigger >= length)) {
+    return false;
+  }
+  _buffers = buffers;
+  _length = length;
+  _pre = pre_trigger;
+  _active = 0;
+  _head = 0;
+  _filled = 0;
+  _remaining = 0;
+  _have_last = false;
+  _external_seen = _external;
+  _ready = false;
+  _missed = 0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets what starts a capture. trigger() works with every type.
+    @param type The trigger condition
+    @param channel 0, 1 or 2 for x, y or z, or MMC56X3_SCOPE_MAGNITUDE
+    @param level Raw counts: the crossing level for rising and falling
+    triggers, the smallest change between two samples for a slope trigger
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Scope::setTrigger(mmc56x3_trigger_t type,
+                                        uint8_t channel, int32_t level) {
+  _type = type;
+  _channel = (channel > MMC56X3_SCOPE_MAGNITUDE) ? 0 : channel;
+  _level = level;
+  _have_last = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fires the trigger on the next sample, e.g. from another sensor
+    or a pin interrupt. It only bumps a counter, which update() compares
+    with the count it last saw, so a trigger arriving while update() runs
+    is kept for the next sample rather than cleared unseen.
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Scope::trigger(void) { _external++; }
+
+/**************************************************************************/
+/*!
+    @brief  Stores one sample and runs the trigger. Call it for every
+    sample at the sensor's output rate.
+    @param sample The sample and its timestamp
+    @returns True when this sample completed a capture, which is now
+    available() to read
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Scope::update(const mmc56x3_sample_t &sample) {
+  if (!_buffers) {
+    return false;
+  }
+
+  mmc56x3_sample_t *buffer = _buffers + (uint32_t)_active * _length;
+  buffer[_head] = sample;
+  if (++_head == _length) {
+    _head = 0;
+  }
+  if (_filled < _length) {
+    _filled++;
+  }
+
+  // a single byte read, and a trigger() after it still differs from
+  // _external_seen on the next sample
+  uint8_t external = _external;
+  bool fired = checkTrigger(channelValue(sample.raw)) ||
+               (external != _external_seen);
+  _external_seen = external;
+
+  if (!_remaining) {
+    if (!fired) {
+      return false;
+    }
+    if (_ready) {
+      // nowhere to continue into while the last capture is being read
+      _missed++;
+      return false;
+    }
+    _pre_count = (_filled - 1 < _pre) ? _filled - 1 : _pre;
+    _remaining = _length - _pre;
+  }
+
+  if (--_remaining) {
+    return false;
+  }
+
+  // freeze this buffer as the capture and carry on in the other one
+  _frozen_length = _pre_count + _length - _pre;
+  _frozen_start = (_head + _length - _frozen_length) % _length;
+  _frozen_trigger = _pre_count;
+  _active ^= 1;
+  _head = 0;
+  _filled = 0;
+  _ready = true;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Stores one sample, timestamped now, and runs the trigger
+    @param raw The x, y and z raw counts, e.g. from readRaw()
+    @returns True when this sample completed a capture
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Scope::update(const int32_t raw[3]) {
+  mmc56x3_sample_t sample;
+  memcpy(sample.raw, raw, sizeof(sample.raw));
+  sample.timestamp = micros();
+  return update(sample);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets a sample of the frozen capture, in time order
+    @param index 0 for the oldest, getTriggerIndex() for the trigger
+    sample, up to getLength() - 1
+    @returns The sample, or NULL if there is no capture or index is past
+    its end. It stays valid until release().
+*/
+/**************************************************************************/
+const mmc56x3_sample_t *Adafruit_MMC56x3_Scope::getSample(uint16_t index) {
+  if (!_ready || (index >= _frozen_length)) {
+    return NULL;
+  }
+  const mmc56x3_sample_t *frozen =
+      _buffers + (uint32_t)(_active ^ 1) * _length;
+  return &frozen[(_frozen_start + index) % _length];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Hands the frozen capture's buffer back, allowing the next
+    trigger
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Scope::release(void) { _ready = false; }
+
+/**************************************************************************/
+/*!
+    @brief  Picks the trigger channel out of a sample
+    @param raw The x, y and z raw counts
+    @returns The axis value, or the field magnitude in counts
+*/
+/**************************************************************************/
+int32_t Adafruit_MMC56x3_Scope::channelValue(const int32_t raw[3]) {
+  if (_channel < 3) {
+    return raw[_channel];
+  }
+  uint64_t sum = 0;
+  for (uint8_t a = 0; a < 3; a++) {
+    sum += (int64_t)raw[a] * raw[a];
+  }
+  return mmc56x3_isqrt64(sum);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Evaluates the trigger condition against the previous sample,
+    so level triggers fire once per crossing rather than for as long as
+    the level is exceeded
+    @param value The channel value of the new sample
+    @returns True if the trigger fired
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Scope::checkTrigger(int32_t value) {
+  int32_t last = _last;
+  bool have_last = _have_last;
+  _last = value;
+  _have_last = true;
+  if (!have_last) {
+    return false;
+  }
+
+  switch (_type) {
+  case MMC56X3_TRIGGER_RISING:
+    return (last < _level) && (value >= _level);
+  case MMC56X3_TRIGGER_FALLING:
+    return (last > _level) && (value <= _level);
+  case MMC56X3_TRIGGER_SLOPE: {
+    int32_t change = value - last;
+    return ((change < 0) ? -change : change) >= _level;
+  }
+  default:
+    return false;
+  }
+}
@@ -0,0 +1,100 @@
+/*!
+ * @file Adafruit_MMC56x3_Scope.h
+ *
+ * Triggered captures of the MMC5603 sample stream with pre-trigger
+ * history, like an oscilloscope's single shot mode
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_SCOPE_H
+#define MMC56X3_SCOPE_H
+
+#include "Adafruit_MMC56x3.h"
+
+#define MMC56X3_SCOPE_MAGNITUDE 3 //!< Trigger channel for the field strength
+
+/*!
+ * @brief What starts a capture, besides trigger()
+ */
+typedef enum {
+  MMC56X3_TRIGGER_EXTERNAL, ///< only trigger() starts a capture
+  MMC56X3_TRIGGER_RISING,   ///< channel rises through the level
+  MMC56X3_TRIGGER_FALLING,  ///< channel falls through the level
+  MMC56X3_TRIGGER_SLOPE,    ///< channel moves by level or more in one sample
+} mmc56x3_trigger_t;
+
+/**************************************************************************/
+/*!
+    @brief  Keeps the latest samples in a circular buffer and, when the
+    trigger fires, records a post-trigger window after them and freezes
+    the whole capture for readout. Two buffers in caller memory take
+    turns: a frozen capture is read from one while acquisition carries on
+    into the other, so update() never stops storing samples. Triggers that
+    fire while a frozen capture is still unread are counted as missed.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Scope {
+public:
+  Adafruit_MMC56x3_Scope(void);
+
+  bool begin(mmc56x3_sample_t *buffers, uint16_t length,
+             uint16_t pre_trigger);
+  void setTrigger(mmc56x3_trigger_t type, uint8_t channel = 0,
+                  int32_t level = 0);
+  void trigger(void);
+
+  bool update(const mmc56x3_sample_t &sample);
+  bool update(const int32_t raw[3]);
+
+  /*! @brief Checks for a frozen capture @returns True until release() */
+  bool available(void) { return _ready; }
+  /*! @brief Checks whether the post-trigger window is being recorded
+      @returns True between the trigger and the capture freezing */
+  bool isTriggered(void) { return _remaining != 0; }
+  /*! @brief Samples in the frozen capture, shorter than the buffer if
+      the trigger came before the history filled @returns Sample count */
+  uint16_t getLength(void) { return _frozen_length; }
+  /*! @brief Position of the trigger sample in the frozen capture
+      @returns Index for getSample() */
+  uint16_t getTriggerIndex(void) { return _frozen_trigger; }
+  const mmc56x3_sample_t *getSample(uint16_t index);
+  void release(void);
+
+  /*! @brief Triggers ignored because the last capture was not released
+      @returns Missed trigger count */
+  uint32_t getMissedTriggers(void) { return _missed; }
+
+private:
+  int32_t channelValue(const int32_t raw[3]);
+  bool checkTrigger(int32_t value);
+
+  mmc56x3_sample_t *_buffers = NULL; ///< two buffers of _length samples
+  uint16_t _length = 0;              ///< samples per buffer and capture
+  uint16_t _pre = 0;                 ///< samples kept before the trigger
+  uint8_t _active = 0;               ///< buffer being acquired into
+  uint16_t _head = 0;                ///< next write index in _active
+  uint16_t _filled = 0;              ///< samples held in _active
+  uint16_t _remaining = 0;           ///< post-trigger samples still due
+  uint16_t _pre_count = 0;           ///< history behind the current trigger
+
+  mmc56x3_trigger_t _type = MMC56X3_TRIGGER_EXTERNAL;
+  uint8_t _channel = 0;
+  int32_t _level = 0;
+  int32_t _last = 0;       ///< channel value of the previous sample
+  bool _have_last = false; ///< _last is valid
+
+  volatile uint8_t _external = 0; ///< trigger() calls, wrapping
+  uint8_t _external_seen = 0;     ///< _external as update() last saw it
+  volatile bool _ready = false;   ///< the other buffer holds a capture
+  uint16_t _frozen_start = 0;     ///< oldest sample of the capture
+  uint16_t _frozen_length = 0;    ///< samples in the capture
+  uint16_t _frozen_trigger = 0;   ///< trigger sample's capture index
+  uint32_t _missed = 0;
+};
+
+#endif
@@ -0,0 +1,182 @@
+/*!
+ * @file Adafruit_MMC56x3_Stream.cpp
+ *
+ * Compact binary framing of MMC5603 samples for streaming to a host, with
+ * sequence numbers, timestamps and a CRC so the receiver can detect loss
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Stream.h"
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a stream with no output
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_Stream::Adafruit_MMC56x3_Stream(void) {
+  memset(&_sample, 0, sizeof(_sample));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets where write() sends frames and restarts the sequence
+    @param out Serial port, file or other Print
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Stream::begin(Print *out) {
+  _out = out;
+  _seq_out = 0;
+  _short_writes = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Frames and writes one sample. The sequence number advances even
+    if the write falls short, so the receiver sees the gap.
+    @param sample The sample, e.g. filled by readRaw() and micros()
+    @param sensor Sensor number 0-15, for several sensors on one stream
+    @returns True if the whole frame was written
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Stream::write(const mmc56x3_sample_t *sample,
+                                    uint8_t sensor) {
+  if (!_out) {
+    return false;
+  }
+  uint8_t frame[MMC56X3_FRAME_LEN];
+  encode(sample, sensor, _seq_out++, frame);
+  if (_out->write(frame, MMC56X3_FRAME_LEN) != MMC56X3_FRAME_LEN) {
+    _short_writes++;
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Feeds one received byte to the frame parser. It locks on to a
+    sync byte followed by a frame with a good CRC, and slides forward a
+    byte at a time to resynchronize after corruption.
+    @param c The byte
+    @returns True when it completed a frame, see getSample()
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Stream::parse(uint8_t c) {
+  _frame[_len++] = c;
+  if (_len < MMC56X3_FRAME_LEN) {
+    if ((_len == 1) && (c != MMC56X3_FRAME_SYNC)) {
+      _len = 0;
+      _discarded++;
+    }
+    return false;
+  }
+
+  uint16_t seq;
+  if (decode(_frame, &_sample, &_sensor, &seq)) {
+    if (_synced) {
+      _lost += (uint16_t)(seq - _seq_in - 1);
+    }
+    _seq_in = seq;
+    _synced = true;
+    _len = 0;
+    return true;
+  }
+
+  // bad frame, drop the leading byte and look for the next sync. The
+  // sequence numbers still count the frames lost in the meantime.
+  uint8_t start = 1;
+  while ((start < MMC56X3_FRAME_LEN) && (_frame[start] != MMC56X3_FRAME_SYNC))
+    start++;
+  _discarded += start;
+  _len = MMC56X3_FRAME_LEN - start;
+  memmove(_frame, _frame + start, _len);
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Packs a sample into a frame
+    @param sample The sample
+    @param sensor Sensor number 0-15
+    @param seq Sequence number
+    @param frame Filled with MMC56X3_FRAME_LEN bytes
+*/
+/**************************************************************************/
+void Adafruit_MMC56x3_Stream::encode(const mmc56x3_sample_t *sample,
+                                     uint8_t sensor, uint16_t seq,
+                                     uint8_t frame[MMC56X3_FRAME_LEN]) {
+  uint64_t word = (uint64_t)(sensor & 0x0F) << 60;
+  for (uint8_t a = 0; a < 3; a++) {
+    uint32_t counts = (uint32_t)(sample->raw[a] + (1L << 19)) & 0xFFFFF;
+    word |= (uint64_t)counts << (20 * a);
+  }
+
+  frame[0] = MMC56X3_FRAME_SYNC;
+  frame[1] = seq;
+  frame[2] = seq >> 8;
+  for (uint8_t i = 0; i < 4; i++) {
+    frame[3 + i] = sample->timestamp >> (8 * i);
+  }
+  for (uint8_t i = 0; i < 8; i++) {
+    frame[7 + i] = word >> (8 * i);
+  }
+  frame[15] = crc8(frame + 1, 14);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Checks and unpacks a frame
+    @param frame MMC56X3_FRAME_LEN bytes starting with the sync byte
+    @param sample Filled with the raw counts and timestamp
+    @param sensor Filled with the sensor number
+    @param seq Filled with the sequence number
+    @returns False, leaving the outputs alone, if the sync byte or CRC is
+    wrong
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_Stream::decode(const uint8_t frame[MMC56X3_FRAME_LEN],
+                                     mmc56x3_sample_t *sample, uint8_t *sensor,
+                                     uint16_t *seq) {
+  if ((frame[0] != MMC56X3_FRAME_SYNC) || (crc8(frame + 1, 14) != frame[15])) {
+    return false;
+  }
+
+  uint64_t word = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    word |= (uint64_t)frame[7 + i] << (8 * i);
+  }
+  for (uint8_t a = 0; a < 3; a++) {
+    sample->raw[a] = (int32_t)((word >> (20 * a)) & 0xFFFFF) - (1L << 19);
+  }
+  sample->timestamp = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    sample->timestamp |= (uint32_t)frame[3 + i] << (8 * i);
+  }
+  *sensor = word >> 60;
+  *seq = frame[1] | ((uint16_t)frame[2] << 8);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  CRC-8 with polynomial 0x07 and initial value 0
+    @param data Bytes to check
+    @param len Number of bytes
+    @returns The CRC
+*/
+/**************************************************************************/
+uint8_t Adafruit_MMC56x3_Stream::crc8(const uint8_t *data, uint8_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *data++;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+  }
+  return crc;
+}
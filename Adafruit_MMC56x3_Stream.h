@@ -0,0 +1,86 @@
+/*!
+ * @file Adafruit_MMC56x3_Stream.h
+ *
+ * Compact binary framing of MMC5603 samples for streaming to a host, with
+ * sequence numbers, timestamps and a CRC so the receiver can detect loss
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_STREAM_H
+#define MMC56X3_STREAM_H
+
+#include "Adafruit_MMC56x3.h"
+
+/*=========================================================================
+    FRAME LAYOUT, little endian
+    -----------------------------------------------------------------------
+    byte  0      MMC56X3_FRAME_SYNC
+    bytes 1-2    sequence number, increments per frame and wraps
+    bytes 3-6    timestamp, micros() of the sample
+    bytes 7-14   64 bit word: x in bits 0-19, y in 20-39, z in 40-59, each
+                 offset binary (raw + 2^19) as the sensor outputs them, and
+                 the sensor number in bits 60-63
+    byte  15     CRC-8 (polynomial 0x07, init 0) of bytes 1-14
+    -----------------------------------------------------------------------*/
+#define MMC56X3_FRAME_LEN 16    //!< Bytes per frame
+#define MMC56X3_FRAME_SYNC 0xA5 //!< First byte of every frame
+
+/**************************************************************************/
+/*!
+    @brief  Writes samples as fixed 16 byte frames to any Print (Serial,
+    a file) and parses them back from a byte stream. At 1000 Hz one sensor
+    needs 16 kB/s, within reach of native USB serial or a 230400 baud UART.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Stream {
+public:
+  Adafruit_MMC56x3_Stream(void);
+
+  void begin(Print *out);
+  bool write(const mmc56x3_sample_t *sample, uint8_t sensor = 0);
+
+  bool parse(uint8_t c);
+  /*! @brief The sample from the last frame parse() completed
+      @returns Pointer to the sample */
+  const mmc56x3_sample_t *getSample(void) { return &_sample; }
+  /*! @brief Sensor number of the last parsed frame @returns 0 to 15 */
+  uint8_t getSensor(void) { return _sensor; }
+  /*! @brief Sequence number of the last parsed frame @returns Sequence */
+  uint16_t getSequence(void) { return _seq_in; }
+  /*! @brief Frames missing from sequence gaps @returns Lost frames */
+  uint32_t getLost(void) { return _lost; }
+  /*! @brief Bytes discarded while looking for a valid frame
+      @returns Discarded byte count */
+  uint32_t getDiscarded(void) { return _discarded; }
+  /*! @brief Frames the Print could not take in full
+      @returns Short write count */
+  uint32_t getShortWrites(void) { return _short_writes; }
+
+  static void encode(const mmc56x3_sample_t *sample, uint8_t sensor,
+                     uint16_t seq, uint8_t frame[MMC56X3_FRAME_LEN]);
+  static bool decode(const uint8_t frame[MMC56X3_FRAME_LEN],
+                     mmc56x3_sample_t *sample, uint8_t *sensor,
+                     uint16_t *seq);
+  static uint8_t crc8(const uint8_t *data, uint8_t len);
+
+private:
+  Print *_out = NULL;
+  uint16_t _seq_out = 0;
+  uint32_t _short_writes = 0;
+
+  uint8_t _frame[MMC56X3_FRAME_LEN];
+  uint8_t _len = 0;
+  bool _synced = false;
+  mmc56x3_sample_t _sample;
+  uint8_t _sensor = 0;
+  uint16_t _seq_in = 0;
+  uint32_t _lost = 0;
+  uint32_t _discarded = 0;
+};
+
+#endif
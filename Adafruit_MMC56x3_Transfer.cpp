@@ -0,0 +1,41 @@
+/*!
+ * @file Adafruit_MMC56x3_Transfer.cpp
+ *
+ * Transport interface the MMC5603 driver does all register access through,
+ * with asynchronous reads, and its blocking implementation for TwoWire
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_Transfer.h"
+
+/**************************************************************************/
+/*!
+    @brief  Writes then reads, returning once done and calling the
+    callback before that
+    @param write_buffer Bytes to write, normally the register address
+    @param write_len Number of bytes to write
+    @param read_buffer Where the read bytes go
+    @param read_len Number of bytes to read
+    @param callback Called on completion, or NULL
+    @param context Passed to the callback
+    @returns False if there is no device or the transfer failed
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_BlockingTransfer::startWriteThenRead(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len, mmc56x3_transfer_callback_t callback, void *context) {
+  if (!_dev) {
+    return false;
+  }
+  _status =
+      _dev->write_then_read(write_buffer, write_len, read_buffer, read_len);
+  if (callback) {
+    callback(_status, context);
+  }
+  return _status;
+}
@@ -0,0 +1,121 @@
+/*!
+ * @file Adafruit_MMC56x3_Transfer.h
+ *
+ * Transport interface the MMC5603 driver does all register access through,
+ * with asynchronous reads, and its blocking implementation for TwoWire
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_TRANSFER_H
+#define MMC56X3_TRANSFER_H
+
+#include <Adafruit_I2CDevice.h>
+
+/*!
+ * @brief Called when a transfer finishes, possibly from interrupt context
+ */
+typedef void (*mmc56x3_transfer_callback_t)(bool ok, void *context);
+
+/**************************************************************************/
+/*!
+    @brief  How the driver reaches the sensor's registers. Register
+    writes are blocking, reads can complete in the background, e.g. by
+    DMA. Implement this for another bus or controller, such as a
+    platform's asynchronous I2C or an I3C controller (with the address
+    from dynamic address assignment and SDR private transfers), and hand
+    it to Adafruit_MMC5603::begin() or setTransfer(). The buffers belong to
+    the caller and must stay valid until the transfer is done.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_Transfer {
+public:
+  virtual ~Adafruit_MMC56x3_Transfer(void) {}
+
+  /*! @brief Writes bytes, returning once done
+      @param buffer Register address followed by the data
+      @param len Number of bytes
+      @returns True if the write succeeded */
+  virtual bool write(const uint8_t *buffer, size_t len) = 0;
+
+  /*! @brief Starts writing then reading (repeated start between them)
+      @param write_buffer Bytes to write, normally the register address
+      @param write_len Number of bytes to write
+      @param read_buffer Where the read bytes go
+      @param read_len Number of bytes to read
+      @param callback Called on completion, or NULL
+      @param context Passed to the callback
+      @returns False if the transfer could not be started */
+  virtual bool startWriteThenRead(const uint8_t *write_buffer,
+                                  size_t write_len, uint8_t *read_buffer,
+                                  size_t read_len,
+                                  mmc56x3_transfer_callback_t callback,
+                                  void *context) = 0;
+
+  /*! @brief Whether the last transfer is still running
+      @returns True until it completes */
+  virtual bool isBusy(void) = 0;
+
+  /*! @brief Outcome of the last completed transfer
+      @returns True if it succeeded */
+  virtual bool getStatus(void) = 0;
+
+  /*! @brief Writes then reads, returning once done
+      @param write_buffer Bytes to write, normally the register address
+      @param write_len Number of bytes to write
+      @param read_buffer Where the read bytes go
+      @param read_len Number of bytes to read
+      @returns True if the transfer succeeded */
+  bool writeThenRead(const uint8_t *write_buffer, size_t write_len,
+                     uint8_t *read_buffer, size_t read_len) {
+    if (!startWriteThenRead(write_buffer, write_len, read_buffer, read_len,
+                            NULL, NULL)) {
+      return false;
+    }
+    while (isBusy()) {
+      yield();
+    }
+    return getStatus();
+  }
+};
+
+/**************************************************************************/
+/*!
+    @brief  Runs transfers to completion before returning, through an
+    Adafruit_I2CDevice. The driver's default, works on any board.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_BlockingTransfer : public Adafruit_MMC56x3_Transfer {
+public:
+  /*! @brief Sets the device transfers go to
+      @param dev The device */
+  void setDevice(Adafruit_I2CDevice *dev) { _dev = dev; }
+
+  /*! @brief Writes through the device
+      @param buffer Register address followed by the data
+      @param len Number of bytes
+      @returns True if the write succeeded */
+  bool write(const uint8_t *buffer, size_t len) {
+    return _dev && _dev->write(buffer, len);
+  }
+
+  bool startWriteThenRead(const uint8_t *write_buffer, size_t write_len,
+                          uint8_t *read_buffer, size_t read_len,
+                          mmc56x3_transfer_callback_t callback,
+                          void *context);
+  /*! @brief Never busy, transfers finish inside the start call
+      @returns False */
+  bool isBusy(void) { return false; }
+  /*! @brief Outcome of the last transfer @returns True if it succeeded */
+  bool getStatus(void) { return _status; }
+
+private:
+  Adafruit_I2CDevice *_dev = NULL;
+  bool _status = false;
+};
+
+#endif
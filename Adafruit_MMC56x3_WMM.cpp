@@ -0,0 +1,296 @@
+/*!
+ * @file Adafruit_MMC56x3_WMM.cpp
+ *
+ * Embedded World Magnetic Model evaluator, for declination (true north)
+ * and the expected earth field at a location
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_MMC56x3_WMM.h"
+
+#define WMM_REF_RADIUS 6371.2f //!< Geomagnetic reference radius, km
+#define WGS84_A 6378.137f      //!< WGS84 semi-major axis, km
+#define WGS84_E2 0.00669438f   //!< WGS84 eccentricity squared
+
+/*!
+ * WMM2025 Schmidt semi-normalized coefficients in nT, and their secular
+ * variation in nT/year, as {g, h, dg, dh}. Rows follow WMM.COF, for
+ * n = 1..12 and m = 0..n, so a new model epoch can be dropped in directly.
+ * extras/wmm_check.py checks it against the release's WMM.COF and test
+ * values, and CI runs it against NOAA's download on every build.
+ */
+static const float wmm_coeffs[][4] PROGMEM = {
+    {-29351.8, 0.0, 12.0, 0.0},
+    {-1410.8, 4545.4, 9.7, -21.5},
+    {-2556.6, 0.0, -11.6, 0.0},
+    {2951.1, -3133.6, -5.2, -27.7},
+    {1649.3, -815.1, -8.0, -12.1},
+    {1361.0, 0.0, -1.3, 0.0},
+    {-2404.1, -56.6, -4.2, 4.0},
+    {1243.8, 237.5, 0.4, -0.3},
+    {453.6, -549.5, -15.6, -4.1},
+    {895.0, 0.0, -1.6, 0.0},
+    {799.5, 278.6, -2.4, -1.1},
+    {55.7, -133.9, -6.0, 4.1},
+    {-281.1, 212.0, 5.6, 1.6},
+    {12.1, -375.6, -7.0, -4.4},
+    {-233.2, 0.0, 0.6, 0.0},
+    {368.9, 45.4, 1.4, -0.5},
+    {187.2, 220.2, 0.0, 2.2},
+    {-138.7, -122.9, 0.6, 0.4},
+    {-142.0, 43.0, 2.2, 1.7},
+    {20.9, 106.1, 0.9, 1.9},
+    {64.4, 0.0, -0.2, 0.0},
+    {63.8, -18.4, -0.4, 0.3},
+    {76.9, 16.8, 0.9, -1.6},
+    {-115.7, 48.8, 1.2, -0.4},
+    {-40.9, -59.8, -0.9, 0.9},
+    {14.9, 10.9, 0.3, 0.7},
+    {-60.7, 72.7, 0.9, 0.9},
+    {79.5, 0.0, 0.0, 0.0},
+    {-77.0, -48.9, -0.1, 0.6},
+    {-8.8, -14.4, -0.1, 0.5},
+    {59.3, -1.0, 0.5, -0.8},
+    {15.8, 23.4, -0.1, 0.0},
+    {2.5, -7.4, -0.8, -1.0},
+    {-11.1, -25.1, -0.8, 0.6},
+    {14.2, -2.3, 0.8, -0.2},
+    {23.2, 0.0, -0.1, 0.0},
+    {10.8, 7.1, 0.2, -0.2},
+    {-17.5, -12.6, 0.0, 0.5},
+    {2.0, 11.4, 0.5, -0.4},
+    {-21.7, -9.7, -0.1, 0.4},
+    {16.9, 12.7, 0.3, -0.5},
+    {15.0, 0.7, 0.2, -0.6},
+    {-16.8, -5.2, 0.0, 0.3},
+    {0.9, 3.9, 0.2, 0.2},
+    {4.6, 0.0, 0.0, 0.0},
+    {7.8, -24.8, -0.1, -0.3},
+    {3.0, 12.2, 0.1, 0.3},
+    {-0.2, 8.3, 0.3, -0.3},
+    {-2.5, -3.3, -0.3, 0.3},
+    {-13.1, -5.2, 0.0, 0.2},
+    {2.4, 7.2, 0.3, -0.1},
+    {8.6, -0.6, -0.1, -0.2},
+    {-8.7, 0.8, 0.1, 0.4},
+    {-12.9, 10.0, -0.1, 0.1},
+    {-1.3, 0.0, 0.1, 0.0},
+    {-6.4, 3.3, 0.0, 0.0},
+    {0.2, 0.0, 0.1, 0.0},
+    {2.0, 2.4, 0.1, -0.2},
+    {-1.0, 5.3, 0.0, 0.1},
+    {-0.6, -9.1, -0.3, -0.1},
+    {-0.9, 0.4, 0.0, 0.1},
+    {1.5, -4.2, -0.1, 0.0},
+    {0.9, -3.8, -0.1, -0.1},
+    {-2.7, 0.9, 0.0, 0.2},
+    {-3.9, -9.1, 0.0, 0.0},
+    {2.9, 0.0, 0.0, 0.0},
+    {-1.5, 0.0, 0.0, 0.0},
+    {-2.5, 2.9, 0.0, 0.1},
+    {2.4, -0.6, 0.0, 0.0},
+    {-0.6, 0.2, 0.0, 0.1},
+    {-0.1, 0.5, -0.1, 0.0},
+    {-0.6, -0.3, 0.0, 0.0},
+    {-0.1, -1.2, 0.0, 0.1},
+    {1.1, -1.7, -0.1, 0.0},
+    {-1.0, -2.9, -0.1, 0.0},
+    {-0.2, -1.8, -0.1, 0.0},
+    {2.6, -2.3, -0.1, 0.0},
+    {-2.0, 0.0, 0.0, 0.0},
+    {-0.2, -1.3, 0.0, 0.0},
+    {0.3, 0.7, 0.0, 0.0},
+    {1.2, 1.0, 0.0, -0.1},
+    {-1.3, -1.4, 0.0, 0.1},
+    {0.6, 0.0, 0.0, 0.0},
+    {0.6, 0.6, 0.1, 0.0},
+    {0.5, -0.1, 0.0, 0.0},
+    {-0.1, 0.8, 0.0, 0.0},
+    {-0.4, 0.1, 0.0, 0.0},
+    {-0.2, -1.0, -0.1, 0.0},
+    {-1.3, 0.1, 0.0, 0.0},
+    {-0.7, 0.2, -0.1, -0.1},
+};
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new model evaluator
+*/
+/**************************************************************************/
+Adafruit_MMC56x3_WMM::Adafruit_MMC56x3_WMM(void) {
+  memset(&_cached, 0, sizeof(_cached));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Computes the earth field at a place and time. Results for the
+    same inputs as the previous call come straight from the cache.
+    @param latitude Geodetic latitude in degrees, north positive
+    @param longitude Longitude in degrees, east positive
+    @param altitude Height above the WGS84 ellipsoid in km
+    @param year Decimal year, see decimalYear()
+    @param result Filled with the predicted field
+    @returns True if the date is inside the model's 5 year validity
+*/
+/**************************************************************************/
+bool Adafruit_MMC56x3_WMM::compute(float latitude, float longitude,
+                                   float altitude, float year,
+                                   mmc56x3_wmm_t *result) {
+  float dt = year - MMC56X3_WMM_EPOCH;
+  bool valid = (dt >= 0) && (dt <= 5);
+
+  if ((latitude == _lat) && (longitude == _lon) && (altitude == _alt) &&
+      (year == _year)) {
+    *result = _cached;
+    return valid;
+  }
+
+  // geodetic to geocentric spherical coordinates
+  float lat_rad = latitude * DEG_TO_RAD;
+  float sin_lat = sinf(lat_rad);
+  float cos_lat = cosf(lat_rad);
+  float rc = WGS84_A / sqrtf(1 - WGS84_E2 * sin_lat * sin_lat);
+  float p = (rc + altitude) * cos_lat;
+  float z = (rc * (1 - WGS84_E2) + altitude) * sin_lat;
+  float r = sqrtf(p * p + z * z);
+  float ct = z / r; // cos(colatitude) = sin(geocentric latitude)
+  float st = p / r; // sin(colatitude) = cos(geocentric latitude)
+
+  // cos(m * lon) and sin(m * lon) come from angle addition, not trig calls
+  float lon_rad = longitude * DEG_TO_RAD;
+  float cos_lon = cosf(lon_rad);
+  float sin_lon = sinf(lon_rad);
+
+  // Gauss normalized Legendre functions and their colatitude derivatives,
+  // keeping only rows n-1 and n-2 of the recurrence
+  float p1[MMC56X3_WMM_DEGREE + 1], p2[MMC56X3_WMM_DEGREE + 1];
+  float dp1[MMC56X3_WMM_DEGREE + 1], dp2[MMC56X3_WMM_DEGREE + 1];
+  float pn[MMC56X3_WMM_DEGREE + 1], dpn[MMC56X3_WMM_DEGREE + 1];
+  p1[0] = 1;
+  dp1[0] = 0;
+
+  float ratio = WMM_REF_RADIUS / r;
+  float ar = ratio * ratio; // (a/r)^(n+2), stepped once per degree
+  float schmidt_n0 = 1;     // Schmidt to Gauss factor for (n, 0)
+  float bx = 0, by = 0, bz = 0;
+  uint8_t idx = 0;
+
+  for (uint8_t n = 1; n <= MMC56X3_WMM_DEGREE; n++) {
+    ar *= ratio;
+    schmidt_n0 *= (float)(2 * n - 1) / n;
+    float schmidt = schmidt_n0;
+    float cos_m = 1, sin_m = 0;
+
+    for (uint8_t m = 0; m <= n; m++, idx++) {
+      if (m == n) {
+        pn[m] = st * p1[m - 1];
+        dpn[m] = st * dp1[m - 1] + ct * p1[m - 1];
+      } else if (n == 1) {
+        pn[m] = ct * p1[m];
+        dpn[m] = ct * dp1[m] - st * p1[m];
+      } else {
+        float k = (float)((n - 1) * (n - 1) - m * m) /
+                  (float)((2 * n - 1) * (2 * n - 3));
+        float pm2 = (m <= n - 2) ? p2[m] : 0;
+        float dpm2 = (m <= n - 2) ? dp2[m] : 0;
+        pn[m] = ct * p1[m] - k * pm2;
+        dpn[m] = ct * dp1[m] - st * p1[m] - k * dpm2;
+      }
+
+      if (m > 0) {
+        schmidt *= sqrtf((float)((n - m + 1) * ((m == 1) ? 2 : 1)) / (n + m));
+        float c = cos_m * cos_lon - sin_m * sin_lon;
+        sin_m = sin_m * cos_lon + cos_m * sin_lon;
+        cos_m = c;
+      }
+
+      float g = pgm_read_float(&wmm_coeffs[idx][0]) +
+                dt * pgm_read_float(&wmm_coeffs[idx][2]);
+      float h = pgm_read_float(&wmm_coeffs[idx][1]) +
+                dt * pgm_read_float(&wmm_coeffs[idx][3]);
+      g *= schmidt;
+      h *= schmidt;
+
+      float gh_c = g * cos_m + h * sin_m;
+      bx += ar * gh_c * dpn[m];
+      bz -= ar * (n + 1) * gh_c * pn[m];
+      if ((m > 0) && (st != 0)) {
+        by += ar * m * (g * sin_m - h * cos_m) * pn[m] / st;
+      }
+    }
+
+    memcpy(p2, p1, sizeof(p1));
+    memcpy(dp2, dp1, sizeof(dp1));
+    memcpy(p1, pn, sizeof(pn));
+    memcpy(dp1, dpn, sizeof(dpn));
+  }
+
+  // rotate from geocentric back to geodetic north/down
+  float sin_psi = ct * cos_lat - st * sin_lat; // sin(geocentric - geodetic)
+  float cos_psi = st * cos_lat + ct * sin_lat;
+  float north = bx * cos_psi - bz * sin_psi;
+  float down = bx * sin_psi + bz * cos_psi;
+
+  // nT to uT
+  _cached.north = north / 1000;
+  _cached.east = by / 1000;
+  _cached.down = down / 1000;
+  _cached.horizontal = sqrtf(north * north + by * by) / 1000;
+  _cached.total = sqrtf(north * north + by * by + down * down) / 1000;
+  _cached.declination = atan2f(by, north) * RAD_TO_DEG;
+  _cached.inclination =
+      atan2f(down, sqrtf(north * north + by * by)) * RAD_TO_DEG;
+
+  _lat = latitude;
+  _lon = longitude;
+  _alt = altitude;
+  _year = year;
+  *result = _cached;
+  return valid;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Convenience to get just the declination at sea level
+    @param latitude Geodetic latitude in degrees, north positive
+    @param longitude Longitude in degrees, east positive
+    @param year Decimal year, see decimalYear()
+    @returns Declination in degrees, add it to a magnetic heading to get a
+    true heading
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_WMM::getDeclination(float latitude, float longitude,
+                                           float year) {
+  mmc56x3_wmm_t result;
+  compute(latitude, longitude, 0, year, &result);
+  return result.declination;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Converts a calendar date to the decimal year the model uses
+    @param year Full year, e.g. 2026
+    @param month 1 to 12
+    @param day 1 to 31
+    @returns Decimal year
+*/
+/**************************************************************************/
+float Adafruit_MMC56x3_WMM::decimalYear(uint16_t year, uint8_t month,
+                                        uint8_t day) {
+  static const uint16_t days_before[12] = {0,   31,  59,  90,  120, 151,
+                                           181, 212, 243, 273, 304, 334};
+  bool leap = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+  if ((month < 1) || (month > 12)) {
+    month = 1;
+  }
+  uint16_t doy = days_before[month - 1] + day - 1;
+  if (leap && (month > 2)) {
+    doy++;
+  }
+  return year + (float)doy / (leap ? 366 : 365);
+}
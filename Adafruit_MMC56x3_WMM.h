@@ -0,0 +1,62 @@
+/*!
+ * @file Adafruit_MMC56x3_WMM.h
+ *
+ * Embedded World Magnetic Model evaluator, for declination (true north)
+ * and the expected earth field at a location
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing products
+ * from Adafruit!
+ *
+ * BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef MMC56X3_WMM_H
+#define MMC56X3_WMM_H
+
+#include "Arduino.h"
+
+#define MMC56X3_WMM_EPOCH 2025.0f //!< Model epoch, decimal year
+#define MMC56X3_WMM_DEGREE 12     //!< Spherical harmonic degree
+
+/*!
+ * @brief Earth field predicted by the model, in geodetic (local level)
+ * coordinates
+ */
+typedef struct {
+  float declination; ///< Degrees, east of true north is positive
+  float inclination; ///< Degrees, below horizontal is positive
+  float total;       ///< Total intensity in uTesla
+  float horizontal;  ///< Horizontal intensity in uTesla
+  float north;       ///< North component in uTesla
+  float east;        ///< East component in uTesla
+  float down;        ///< Down component in uTesla
+} mmc56x3_wmm_t;
+
+/**************************************************************************/
+/*!
+    @brief  Evaluates the World Magnetic Model in single precision, with
+    the coefficient table in flash and a rolling Legendre recurrence so
+    stack use stays small. The last result is cached, so calling compute()
+    repeatedly for the same place and date is free.
+*/
+/**************************************************************************/
+class Adafruit_MMC56x3_WMM {
+public:
+  Adafruit_MMC56x3_WMM(void);
+
+  bool compute(float latitude, float longitude, float altitude, float year,
+               mmc56x3_wmm_t *result);
+  float getDeclination(float latitude, float longitude, float year);
+
+  static float decimalYear(uint16_t year, uint8_t month, uint8_t day);
+
+private:
+  float _lat = NAN;      ///< cached latitude
+  float _lon = NAN;      ///< cached longitude
+  float _alt = NAN;      ///< cached altitude
+  float _year = NAN;     ///< cached date
+  mmc56x3_wmm_t _cached; ///< cached result
+};
+
+#endif
@@ -0,0 +1,52 @@
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_ACCurrent.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+Adafruit_MMC56x3_ACCurrent meter;
+
+// distance from the center of the wire to the sensor, in meters
+#define WIRE_DISTANCE 0.01
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Contactless AC Current Meter");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+  Wire.setClock(400000); // 1000 Hz needs fast mode I2C
+
+  // 1000 Hz continuous, 200 sample (200 ms) windows
+  meter.begin(&mmc, 200);
+  // the wire runs along x, above the sensor, so its field circles through y
+  meter.setDirection(0, 1, 0);
+  // long straight wire: amps = 5 * distance * uT
+  meter.setScale(5 * WIRE_DISTANCE);
+}
+
+void loop(void) {
+  static uint32_t next_sample = micros();
+
+  // pace reads to the sensor's output rate
+  while ((int32_t)(micros() - next_sample) < 0)
+    ;
+  next_sample += 1000;
+
+  int32_t raw[3];
+  if (!mmc.readRaw(raw) || !meter.update(raw))
+    return;
+
+  Serial.print("RMS: "); Serial.print(meter.getRMS(), 3);
+  Serial.print(" uT  Peak: "); Serial.print(meter.getPeak(), 3);
+  Serial.print(" uT  Current: "); Serial.print(meter.getCurrent(), 3);
+  Serial.println(" A");
+}
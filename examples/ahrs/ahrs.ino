@@ -0,0 +1,73 @@
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_AHRS.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+Adafruit_MMC56x3_AHRS ahrs;
+
+#define SAMPLE_RATE 100
+
+// Hard iron offsets from the calibration example, in uT
+float mag_offsets[3] = {0, 0, 0};
+
+uint32_t update_micros = 0;
+uint16_t updates = 0;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 AHRS");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(SAMPLE_RATE);
+  mmc.setContinuousMode(true);
+
+  // run the filter at the magnetometer's data rate
+  ahrs.begin(SAMPLE_RATE, 0.1);
+}
+
+void loop(void) {
+  static uint32_t next_sample = millis();
+
+  if ((int32_t)(millis() - next_sample) < 0)
+    return;
+  next_sample += 1000 / SAMPLE_RATE;
+
+  sensors_event_t mag;
+  mmc.getEvent(&mag);
+
+  // Replace with readings from your accelerometer (and gyro, in rad/s).
+  // This assumes the board is lying flat and still.
+  float ax = 0, ay = 0, az = 9.8;
+  float gx = 0, gy = 0, gz = 0;
+
+  uint32_t start = micros();
+  ahrs.update(gx, gy, gz, ax, ay, az,
+              mag.magnetic.x - mag_offsets[0],
+              mag.magnetic.y - mag_offsets[1],
+              mag.magnetic.z - mag_offsets[2]);
+  update_micros += micros() - start;
+
+  // print once a second
+  if (++updates < SAMPLE_RATE)
+    return;
+
+  Serial.print("Roll: "); Serial.print(ahrs.getRoll());
+  Serial.print("  Pitch: "); Serial.print(ahrs.getPitch());
+  Serial.print("  Yaw: "); Serial.print(ahrs.getYaw());
+  Serial.print("  (");
+  Serial.print((float)update_micros / updates);
+  Serial.println(" us per update)");
+  update_micros = 0;
+  updates = 0;
+}
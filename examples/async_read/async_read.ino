@@ -0,0 +1,57 @@
+// Reads the data registers with the asynchronous interface. With the
+// default blocking transfer the read is done when startDataRead() returns,
+// but the same sketch frees the CPU during the read once a DMA backed
+// Adafruit_MMC56x3_Transfer is passed to mmc.setTransfer().
+
+#include <Adafruit_MMC56x3.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+volatile bool read_done = false;
+
+void onReadDone(bool ok, void *context) {
+  // may run in interrupt context, so just flag it
+  read_done = true;
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Async Read");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(10);
+  mmc.setContinuousMode(true);
+}
+
+void loop(void) {
+  static uint32_t next_read = millis();
+
+  if ((int32_t)(millis() - next_read) >= 0) {
+    next_read += 100;
+    mmc.startDataRead(onReadDone);
+  }
+
+  // other work can go here while the transfer runs
+
+  if (read_done) {
+    read_done = false;
+    int32_t raw[3];
+    if (mmc.finishDataRead(raw)) {
+      Serial.print("X: "); Serial.print(raw[0] * MMC56X3_LSB_UT);
+      Serial.print("  Y: "); Serial.print(raw[1] * MMC56X3_LSB_UT);
+      Serial.print("  Z: "); Serial.print(raw[2] * MMC56X3_LSB_UT);
+      Serial.println(" uT");
+    }
+  }
+}
@@ -0,0 +1,44 @@
+// Streams raw 1000 Hz samples to the host as 16 byte binary frames with a
+// sequence number, micros() timestamp and CRC, for a host side reader to
+// unpack with Adafruit_MMC56x3_Stream::parse() or the frame layout in
+// Adafruit_MMC56x3_Stream.h. Needs native USB or a fast UART, 115200 baud
+// only carries about 700 frames a second.
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Stream.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+Adafruit_MMC56x3_Stream stream;
+
+void setup(void) {
+  Serial.begin(921600);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(1000);
+  mmc.setContinuousMode(true);
+  stream.begin(&Serial);
+}
+
+void loop(void) {
+  static uint32_t next_sample = micros();
+
+  // pace reads to the sensor's output rate
+  while ((int32_t)(micros() - next_sample) < 0)
+    ;
+  next_sample += 1000;
+
+  mmc56x3_sample_t sample;
+  if (mmc.readRaw(sample.raw)) {
+    sample.timestamp = micros();
+    stream.write(&sample);
+  }
+}
@@ -0,0 +1,84 @@
+// Shares one MMC5603 stream between three consumers without copying it to
+// each: a logger that prints every sample, a heading display that reads
+// the latest only now and then, and a disturbance detector. Each has its
+// own cursor and reports samples it missed.
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Broadcast.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+Adafruit_MMC56x3_Broadcast<32> ring;
+mmc56x3_cursor_t logger, display, detector;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Broadcast Ring");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(100);
+  mmc.setContinuousMode(true);
+
+  ring.attach(&logger);
+  ring.attach(&display);
+  ring.attach(&detector);
+}
+
+void loop(void) {
+  // writer: fill the next slot in place, at the sensor's output rate
+  static uint32_t next_sample = micros();
+  if ((int32_t)(micros() - next_sample) >= 0) {
+    next_sample += 10000;
+    mmc56x3_sample_t *slot = ring.claim();
+    if (mmc.readRaw(slot->raw)) {
+      slot->timestamp = micros();
+      ring.publish();
+    }
+  }
+
+  // logger: every sample, read in place
+  const mmc56x3_sample_t *s;
+  while ((s = ring.peek(&logger)) != NULL) {
+    int32_t x = s->raw[0], y = s->raw[1], z = s->raw[2];
+    if (ring.release(&logger)) {
+      Serial.print(x); Serial.print(",");
+      Serial.print(y); Serial.print(",");
+      Serial.println(z);
+    }
+  }
+
+  // detector: flags large jumps in z
+  static int32_t last_z = 0;
+  mmc56x3_sample_t sample;
+  while (ring.read(&detector, &sample)) {
+    if (abs(sample.raw[2] - last_z) > 1600) { // 10 uT
+      Serial.println("Disturbance!");
+    }
+    last_z = sample.raw[2];
+  }
+
+  // display: twice a second, skipping to the newest sample
+  static uint32_t last_display = 0;
+  if (millis() - last_display >= 500) {
+    last_display = millis();
+    ring.skipToLatest(&display);
+    if (ring.read(&display, &sample)) {
+      float heading = atan2(sample.raw[1], sample.raw[0]) * 180 / PI;
+      Serial.print("Heading: ");
+      Serial.print(heading < 0 ? heading + 360 : heading);
+      Serial.print("  logger lost: ");
+      Serial.println(logger.lost);
+    }
+  }
+}
@@ -0,0 +1,78 @@
+// Benchmarks the sensor at each I2C clock: data register reads per second
+// and one-shot samples per second with separate and burst reads, next to
+// what the driver's timing model predicts. The gap between the two is the
+// core's own time per transaction, tune it with setTransactionOverhead().
+
+#include <Adafruit_MMC56x3.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+const uint32_t speeds[] = {MMC56X3_I2C_STANDARD, MMC56X3_I2C_FAST,
+                           MMC56X3_I2C_FASTPLUS};
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Bus Speed Benchmark");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  for (uint8_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+    uint32_t hz = mmc.setBusSpeed(speeds[i]);
+    Serial.print("Asked for ");
+    Serial.print(speeds[i] / 1000);
+    Serial.print(" kHz, running at ");
+    Serial.print(hz / 1000);
+    Serial.println(" kHz");
+    if (hz != speeds[i]) {
+      continue;
+    }
+
+    // back to back data register reads, as in continuous mode
+    int32_t raw[3];
+    uint32_t start = micros();
+    for (uint16_t n = 0; n < 200; n++) {
+      mmc.readMeasurement(raw);
+    }
+    uint32_t elapsed = micros() - start;
+    Serial.print("  reads/s:   measured ");
+    Serial.print(200000000.0 / elapsed, 0);
+    Serial.print(", predicted ");
+    Serial.println(1000000.0 / mmc.getTransferTime(1, 9), 0);
+
+    // complete one-shot samples, with a status check and then a 9 byte
+    // data read or a 25 byte burst of the whole register block
+    for (uint8_t burst = 0; burst < 2; burst++) {
+      mmc.setReadStrategy(burst ? MMC56X3_READ_BURST : MMC56X3_READ_SEPARATE);
+      start = micros();
+      for (uint16_t n = 0; n < 50; n++) {
+        mmc.readRaw(raw);
+      }
+      elapsed = micros() - start;
+      Serial.print(burst ? "  burst" : "  separate");
+      Serial.print(" samples/s: measured ");
+      Serial.print(50000000.0 / elapsed, 0);
+      Serial.print(", predicted ");
+      Serial.print(1000000.0 / mmc.getSampleTime(), 0);
+      Serial.print(", ready check + read ");
+      Serial.print(mmc.getReadCost(mmc.getReadStrategy()));
+      Serial.println(" us");
+    }
+  }
+
+  mmc.setBusSpeed(MMC56X3_I2C_FAST);
+  mmc.setReadStrategy(MMC56X3_READ_AUTO);
+}
+
+void loop(void) {
+  delay(1000);
+}
@@ -0,0 +1,74 @@
+// Several independent parts of a sketch each call getEvent(): a heading
+// display, a disturbance check and a logger. With a 20 ms cache window
+// the calls that come close together share one measurement instead of
+// each triggering their own, and the hit/miss counts show how often.
+
+#include <Adafruit_MMC56x3.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+float heading = 0;
+uint32_t disturbances = 0;
+
+void updateHeading(void) {
+  sensors_event_t event;
+  mmc.getEvent(&event);
+  heading = atan2(event.magnetic.y, event.magnetic.x) * 180 / PI;
+  if (heading < 0) {
+    heading += 360;
+  }
+}
+
+void checkDisturbance(void) {
+  static float last_z = 0;
+  sensors_event_t event;
+  mmc.getEvent(&event);
+  if (fabs(event.magnetic.z - last_z) > 10) {
+    disturbances++;
+  }
+  last_z = event.magnetic.z;
+}
+
+void logField(void) {
+  sensors_event_t event;
+  mmc.getEvent(&event);
+  Serial.print("t="); Serial.print(event.timestamp);
+  Serial.print(" ms  z="); Serial.print(event.magnetic.z);
+  Serial.print(" uT  heading="); Serial.print(heading);
+  Serial.print("  disturbances="); Serial.println(disturbances);
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Cached Reads");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  // samples up to 20 ms old are good enough for all three users
+  mmc.setMaxAge(20000);
+}
+
+void loop(void) {
+  static uint8_t count = 0;
+
+  updateHeading();
+  checkDisturbance();
+  if (++count == 50) {
+    count = 0;
+    logField();
+    Serial.print("cache hits: "); Serial.print(mmc.getCacheHits());
+    Serial.print("  misses: "); Serial.println(mmc.getCacheMisses());
+    mmc.resetCacheStats();
+  }
+  delay(10);
+}
@@ -0,0 +1,49 @@
+// Gets samples through callbacks instead of polling getEvent(). service()
+// never blocks, it triggers, waits out the conversion and reads in the
+// background, so loop() is free for other work.
+
+#include <Adafruit_MMC56x3.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+uint32_t raw_count = 0;
+
+void onRaw(const int32_t raw[3], void *context) {
+  uint32_t *count = (uint32_t *)context;
+  (*count)++;
+}
+
+void onEvent(sensors_event_t *event, void *context) {
+  Serial.print("X: "); Serial.print(event->magnetic.x);
+  Serial.print("  Y: "); Serial.print(event->magnetic.y);
+  Serial.print("  Z: "); Serial.print(event->magnetic.z);
+  Serial.print(" uT  samples: "); Serial.println(raw_count);
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Callbacks");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(10);
+  mmc.setContinuousMode(true);
+  mmc.setRawCallback(onRaw, &raw_count);
+  mmc.setEventCallback(onEvent);
+}
+
+void loop(void) {
+  mmc.service();
+
+  // anything else can run here without holding up the sensor
+}
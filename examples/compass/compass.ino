@@ -1,8 +1,12 @@
 #include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Heading.h>
 
 /* Assign a unique ID to this sensor at the same time */
 Adafruit_MMC5603 mag = Adafruit_MMC5603(12345);
 
+/* Smooths the heading without glitching at 0/360 */
+Adafruit_MMC56x3_Heading compass;
+
 void setup(void) {
   Serial.begin(115200);
   while (!Serial)
@@ -17,6 +21,9 @@ void setup(void) {
     Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
     while (1) delay(10);
   }
+
+  // 20 Hz updates, 0.5 second time constant, report changes over 2 degrees
+  compass.begin(20, 0.5, 2);
 }
 
 void loop(void)
@@ -25,17 +32,10 @@ void loop(void)
   sensors_event_t event;
   mag.getEvent(&event);
 
-  float Pi = 3.14159;
-
-  // Calculate the angle of the vector y,x
-  float heading = (atan2(event.magnetic.y,event.magnetic.x) * 180) / Pi;
-
-  // Normalize to 0-360
-  if (heading < 0)
-  {
-    heading = 360 + heading;
+  // Only print when the smoothed heading (0-360) has really moved
+  if (compass.update(event.magnetic.x, event.magnetic.y)) {
+    Serial.print("Compass Heading: ");
+    Serial.println(compass.getEventHeading());
   }
-  Serial.print("Compass Heading: ");
-  Serial.println(heading);
-  delay(500);
-}
\ No newline at end of file
+  delay(50);
+}
@@ -0,0 +1,66 @@
+// Drives the MMC5603 from C++20 coroutines: one coroutine awaits
+// measurements while another blinks the LED, both on one small event loop
+// and neither blocking the other. Needs the compiler set to -std=gnu++20 or
+// later, otherwise it just prints a notice.
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Coro.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+#ifdef MMC56X3_HAS_COROUTINES
+
+Adafruit_MMC56x3_EventLoop events;
+
+Adafruit_MMC56x3_EventLoop::Task sampler(void) {
+  int32_t raw[3];
+  for (;;) {
+    if (co_await events.measure(&mmc, raw)) {
+      Serial.print("X: "); Serial.print(raw[0] * MMC56X3_LSB_UT);
+      Serial.print("  Y: "); Serial.print(raw[1] * MMC56X3_LSB_UT);
+      Serial.print("  Z: "); Serial.print(raw[2] * MMC56X3_LSB_UT);
+      Serial.println(" uT");
+    }
+    co_await events.sleep(100000);
+  }
+}
+
+Adafruit_MMC56x3_EventLoop::Task blinker(void) {
+  pinMode(LED_BUILTIN, OUTPUT);
+  for (;;) {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    co_await events.sleep(250000);
+  }
+}
+
+#endif
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Coroutines");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+#ifdef MMC56X3_HAS_COROUTINES
+  sampler();
+  blinker();
+#else
+  Serial.println("This example needs a C++20 compiler");
+#endif
+}
+
+void loop(void) {
+#ifdef MMC56X3_HAS_COROUTINES
+  events.runOnce();
+#endif
+}
@@ -0,0 +1,64 @@
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_FFT.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+// 128 points at 1000 Hz gives 64 bins of 7.8 Hz. Larger sizes need more RAM:
+// 6 bytes per point plus 8 bytes per bin (4 without averaging)
+#define FFT_SIZE 128
+#define SAMPLE_RATE 1000
+
+int16_t capture[FFT_SIZE];
+int16_t fft_real[FFT_SIZE];
+int16_t fft_imag[FFT_SIZE];
+uint32_t power[FFT_SIZE]; // averaging needs room for two sets of bins
+
+Adafruit_MMC56x3_FFT fft;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Spectrum Snapshot");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+  Wire.setClock(400000); // 1000 Hz needs fast mode I2C
+
+  mmc.setDataRate(SAMPLE_RATE);
+  mmc.setContinuousMode(true);
+
+  // average 8 Hann windowed blocks per spectrum
+  fft.begin(FFT_SIZE, capture, fft_real, fft_imag, power, 8, true);
+}
+
+void loop(void) {
+  static uint32_t next_sample = micros();
+
+  // the transform runs one stage at a time in between samples
+  bool spectrum_ready = fft.process();
+
+  if ((int32_t)(micros() - next_sample) >= 0) {
+    next_sample += 1000000 / SAMPLE_RATE;
+    int32_t raw[3];
+    if (mmc.readRaw(raw))
+      fft.addSample(raw[2]); // analyze the z axis
+  }
+
+  if (!spectrum_ready)
+    return;
+
+  for (uint16_t b = 1; b < fft.getNumBins(); b++) {
+    Serial.print(fft.getBinFrequency(b, SAMPLE_RATE), 1);
+    Serial.print(" Hz: ");
+    Serial.println(fft.getPower(b));
+  }
+  Serial.println();
+}
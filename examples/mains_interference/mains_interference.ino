@@ -0,0 +1,70 @@
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Goertzel.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+/* 100 samples at 1000 Hz holds exactly 5 cycles of 50 Hz and 6 of 60 Hz */
+Adafruit_MMC56x3_Goertzel mains;
+
+const char *axis_names[3] = {"X", "Y", "Z"};
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Mains Interference Monitor");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+  Wire.setClock(400000); // 1000 Hz needs fast mode I2C
+
+  mmc.setDataRate(1000); // in Hz, from 1-255 or 1000
+  mmc.setContinuousMode(true);
+
+  mains.begin(1000, 100);
+  mains.addBin(50);
+  mains.addBin(60);
+  mains.addBin(100);
+  mains.addBin(120);
+}
+
+uint8_t blocks = 0;
+
+void loop(void) {
+  static uint32_t next_sample = micros();
+
+  // pace reads to the sensor's output rate
+  while ((int32_t)(micros() - next_sample) < 0)
+    ;
+  next_sample += 1000;
+
+  // cleaned[] has the tones from the last block subtracted out
+  int32_t raw[3], cleaned[3];
+  if (!mmc.readRaw(raw) || !mains.update(raw, cleaned))
+    return;
+
+  // print once every 10 blocks (one second)
+  if (++blocks < 10)
+    return;
+  blocks = 0;
+
+  for (uint8_t b = 0; b < mains.getNumBins(); b++) {
+    Serial.print(mains.getFrequency(b), 0);
+    Serial.print(" Hz:");
+    for (uint8_t a = 0; a < 3; a++) {
+      Serial.print("  ");
+      Serial.print(axis_names[a]);
+      Serial.print(": ");
+      Serial.print(mains.getAmplitude(b, a), 3);
+    }
+    Serial.println(" uT");
+  }
+  Serial.println();
+}
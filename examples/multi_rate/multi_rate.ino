@@ -0,0 +1,84 @@
+// One continuous 1000 Hz stream shared out at three rates: the full rate
+// for a disturbance detector, a 100 Hz average for logging and a 10 Hz
+// average for a heading display. The 10 Hz average is built from the
+// 100 Hz block sums rather than from the raw samples.
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_FanOut.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+Adafruit_MMC56x3_FanOut fanout;
+
+uint32_t disturbances = 0;
+
+void detect(const int32_t out[3], void *context) {
+  static int32_t last_z = 0;
+  if (abs(out[2] - last_z) > 1600) { // 10 uT in one millisecond
+    disturbances++;
+  }
+  last_z = out[2];
+}
+
+void logSample(const int32_t out[3], void *context) {
+  static uint8_t count = 0;
+  if (++count < 100) { // print one line a second to keep up with Serial
+    return;
+  }
+  count = 0;
+  Serial.print(out[0] * MMC56X3_LSB_UT); Serial.print(",");
+  Serial.print(out[1] * MMC56X3_LSB_UT); Serial.print(",");
+  Serial.println(out[2] * MMC56X3_LSB_UT);
+}
+
+void display(const int32_t out[3], void *context) {
+  float heading = atan2(out[1], out[0]) * 180 / PI;
+  if (heading < 0) {
+    heading += 360;
+  }
+  static uint8_t count = 0;
+  if (++count < 10) {
+    return;
+  }
+  count = 0;
+  Serial.print("Heading: "); Serial.print(heading);
+  Serial.print("  disturbances: "); Serial.println(disturbances);
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Multi Rate Fan-out");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(1000);
+  mmc.setContinuousMode(true);
+
+  fanout.begin(1000);
+  fanout.addConsumer(1000, MMC56X3_FANOUT_DECIMATE, detect);
+  fanout.addConsumer(100, MMC56X3_FANOUT_AVERAGE, logSample);
+  fanout.addConsumer(10, MMC56X3_FANOUT_AVERAGE, display);
+}
+
+void loop(void) {
+  static uint32_t next_sample = micros();
+
+  // pace reads to the sensor's output rate
+  while ((int32_t)(micros() - next_sample) < 0)
+    ;
+  next_sample += 1000;
+
+  int32_t raw[3];
+  if (mmc.readRaw(raw)) {
+    fanout.update(raw);
+  }
+}
@@ -0,0 +1,46 @@
+// Samples the MMC5603 from its own FreeRTOS task at 100 Hz. loop() just
+// blocks on the sample queue, and anything else using Wire should take
+// rtos.getBusLock() around its transfers.
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_RTOS.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+Adafruit_MMC56x3_RTOS rtos;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 FreeRTOS Queue");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  if (!rtos.begin(&mmc, 10)) {
+    Serial.println("Could not start the acquisition task");
+    while (1) delay(10);
+  }
+}
+
+void loop(void) {
+  mmc56x3_sample_t sample;
+  if (!rtos.read(&sample)) {
+    return;
+  }
+
+  Serial.print(sample.timestamp);
+  for (uint8_t a = 0; a < 3; a++) {
+    Serial.print("\t");
+    Serial.print(sample.raw[a] * MMC56X3_LSB_UT);
+  }
+  Serial.print("\toverflows: ");
+  Serial.println(rtos.getOverflows());
+}
@@ -0,0 +1,91 @@
+// Oscilloscope style single shots of magnetic events. The sensor runs at
+// 1000 Hz and the last 100 ms are always kept; when the field strength
+// jumps by 5 uT within one sample, e.g. a magnet snapping past or a relay
+// switching, the next 300 ms are recorded after it and the 400 ms capture
+// is printed as CSV, in ms from the trigger. Printing is spread over the
+// following samples so sensing never pauses, and a new trigger can be
+// caught into the other buffer as soon as printing finishes.
+// Send any character over Serial to force a capture.
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Scope.h>
+
+#if defined(__AVR__)
+#define CAPTURE_LEN 32 // 2 KB boards only fit a 32 ms capture
+#define PRE_TRIGGER 8
+#else
+#define CAPTURE_LEN 400
+#define PRE_TRIGGER 100
+#endif
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+Adafruit_MMC56x3_Scope scope;
+
+mmc56x3_sample_t capture_memory[2 * CAPTURE_LEN];
+uint16_t print_index = 0;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Triggered Capture");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(1000);
+  mmc.setContinuousMode(true);
+
+  scope.begin(capture_memory, CAPTURE_LEN, PRE_TRIGGER);
+  // 5 uT = 800 counts
+  scope.setTrigger(MMC56X3_TRIGGER_SLOPE, MMC56X3_SCOPE_MAGNITUDE, 800);
+}
+
+void loop(void) {
+  static uint32_t next_sample = micros();
+  static uint8_t tick = 0;
+
+  // pace reads to the sensor's output rate
+  while ((int32_t)(micros() - next_sample) < 0)
+    ;
+  next_sample += 1000;
+
+  int32_t raw[3];
+  if (mmc.readRaw(raw) && scope.update(raw)) {
+    print_index = 0;
+    Serial.println("ms,x,y,z");
+  }
+
+  if (Serial.available()) {
+    Serial.read();
+    scope.trigger();
+  }
+
+  // one line every 4 samples stays within the serial port's bandwidth
+  if (!scope.available() || (++tick & 3)) {
+    return;
+  }
+  const mmc56x3_sample_t *sample = scope.getSample(print_index);
+  if (!sample) {
+    Serial.print("missed triggers: ");
+    Serial.println(scope.getMissedTriggers());
+    scope.release();
+    return;
+  }
+  const mmc56x3_sample_t *trigger = scope.getSample(scope.getTriggerIndex());
+  Serial.print((int32_t)(sample->timestamp - trigger->timestamp) / 1000.0);
+  Serial.print(",");
+  Serial.print(sample->raw[0] * MMC56X3_LSB_UT);
+  Serial.print(",");
+  Serial.print(sample->raw[1] * MMC56X3_LSB_UT);
+  Serial.print(",");
+  Serial.println(sample->raw[2] * MMC56X3_LSB_UT);
+  print_index++;
+}
@@ -0,0 +1,84 @@
+// Records 1000 Hz raw samples to an SD card in the capture format from
+// Adafruit_MMC56x3_Capture.h, one fixed size binary record per sample.
+// Convert or summarize the file on a computer with
+// extras/mmc56x3_capture.py, e.g. "mmc56x3_capture.py stats MAG.BIN".
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Capture.h>
+#include <SD.h>
+
+#define SD_CS_PIN 10         // chip select of the SD card
+#define RECORD_SECONDS 60    // length of the recording
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+Adafruit_MMC56x3_Capture capture;
+File file;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 SD Capture");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  if (!SD.begin(SD_CS_PIN)) {
+    Serial.println("No SD card found");
+    while (1) delay(10);
+  }
+  SD.remove("MAG.BIN");
+  file = SD.open("MAG.BIN", FILE_WRITE);
+  if (!file) {
+    Serial.println("Could not create MAG.BIN");
+    while (1) delay(10);
+  }
+
+  mmc.setDataRate(1000);
+  mmc.setContinuousMode(true);
+
+  // put any calibration in config.hard_iron and config.soft_iron so the
+  // recording carries it along
+  mmc56x3_capture_config_t config;
+  Adafruit_MMC56x3_Capture::defaultConfig(&config, &mmc);
+  capture.begin(&file, &config);
+  Serial.println("Recording...");
+}
+
+void loop(void) {
+  static uint32_t next_sample = micros();
+  static uint32_t last_flush = millis();
+
+  if (!file) {
+    return;
+  }
+
+  // pace reads to the sensor's output rate
+  while ((int32_t)(micros() - next_sample) < 0)
+    ;
+  next_sample += 1000;
+
+  mmc56x3_sample_t sample;
+  if (mmc.readRaw(sample.raw)) {
+    sample.timestamp = micros();
+    capture.write(&sample);
+  }
+
+  // flush once a second so a power cut loses at most a second of data
+  if (millis() - last_flush >= 1000) {
+    last_flush = millis();
+    file.flush();
+  }
+
+  if (capture.getRecords() >= RECORD_SECONDS * 1000UL) {
+    file.close();
+    Serial.println("Done");
+  }
+}
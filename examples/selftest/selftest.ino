@@ -0,0 +1,39 @@
+#include <Adafruit_MMC56x3.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+const char *axis_names[3] = {"X", "Y", "Z"};
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Self Test");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  mmc56x3_selftest_t result;
+  bool passed = mmc.selfTest(&result);
+
+  for (uint8_t a = 0; a < 3; a++) {
+    Serial.print(axis_names[a]);
+    Serial.print(": measured ");
+    Serial.print(result.delta[a]);
+    Serial.print(" expected ");
+    Serial.print(result.expected[a]);
+    Serial.println(result.pass[a] ? "  PASS" : "  FAIL");
+  }
+  Serial.println(passed ? "Self test PASSED" : "Self test FAILED");
+}
+
+void loop(void) {
+  delay(1000);
+}
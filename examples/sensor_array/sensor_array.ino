@@ -0,0 +1,59 @@
+// Reads several MMC5603s as one synchronized array. Every sensor is
+// triggered before any is read, so all of them convert at the same time
+// and a frame takes one conversion time however many sensors there are.
+// The MMC5603 has a fixed address, so use one sensor per I2C bus (or per
+// multiplexer channel) and list the buses below, e.g. {&Wire, &Wire1}.
+
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Array.h>
+
+TwoWire *buses[] = {&Wire};
+#define NUM_SENSORS (sizeof(buses) / sizeof(buses[0]))
+
+Adafruit_MMC5603 mmc[NUM_SENSORS];
+Adafruit_MMC56x3_Array array;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Sensor Array");
+  Serial.println("");
+
+  for (uint8_t i = 0; i < NUM_SENSORS; i++) {
+    if (!mmc[i].begin(MMC56X3_DEFAULT_ADDRESS, buses[i])) {
+      Serial.print("Ooops, no MMC5603 detected on bus ");
+      Serial.print(i);
+      Serial.println(" ... Check your wiring!");
+      while (1) delay(10);
+    }
+    array.addSensor(&mmc[i]);
+  }
+}
+
+void loop(void) {
+  static mmc56x3_frame_t frame;
+
+  if (!array.isBusy()) {
+    array.start();
+  }
+  // other work can go here, poll() returns straight away until the
+  // conversions are done
+  if (!array.poll(&frame)) {
+    return;
+  }
+
+  Serial.print(frame.timestamp);
+  for (uint8_t i = 0; i < NUM_SENSORS; i++) {
+    for (uint8_t a = 0; a < 3; a++) {
+      Serial.print("\t");
+      if (frame.valid & (1UL << i)) {
+        Serial.print(frame.raw[i][a] * MMC56X3_LSB_UT);
+      } else {
+        Serial.print("-");
+      }
+    }
+  }
+  Serial.println();
+}
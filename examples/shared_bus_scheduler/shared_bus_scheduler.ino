@@ -0,0 +1,69 @@
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_Scheduler.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mmc = Adafruit_MMC5603(12345);
+
+Adafruit_MMC56x3_Scheduler scheduler;
+
+int8_t mag_task, other_task;
+int32_t last_x;
+
+// Called with every magnetometer sample
+void onSample(Adafruit_MMC5603 *sensor, const mmc56x3_sample_t *sample,
+              void *context) {
+  last_x = sample->raw[0];
+}
+
+// Stand-in for another device on the same bus. Do one short transaction
+// here, e.g. read a temperature sensor's data register.
+void otherDevice(void *context) {
+  Wire.beginTransmission(0x48);
+  Wire.endTransmission();
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 Shared Bus Scheduler");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mmc.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  // magnetometer at 50 Hz (one-shot, the conversion time is left free for
+  // other clients) and another bus client at 20 Hz
+  mag_task = scheduler.addSensor(&mmc, 20000, onSample);
+  other_task = scheduler.addClient(50000, otherDevice);
+  scheduler.start();
+}
+
+void loop(void) {
+  static uint32_t last_print = millis();
+
+  // each call does at most one bus transaction
+  scheduler.run();
+
+  if (millis() - last_print < 1000)
+    return;
+  last_print = millis();
+
+  Serial.print("Mag samples/s: "); Serial.print(scheduler.getSamples(mag_task));
+  Serial.print("  worst jitter: ");
+  Serial.print(scheduler.getMaxLateness(mag_task));
+  Serial.print(" us  skipped: ");
+  Serial.print(scheduler.getOverruns(mag_task));
+  Serial.print("  errors: ");
+  Serial.print(scheduler.getErrors(mag_task));
+  Serial.print("  Other runs/s: ");
+  Serial.print(scheduler.getSamples(other_task));
+  Serial.print("  X: ");
+  Serial.println(last_x * MMC56X3_LSB_UT);
+  scheduler.clearStats();
+}
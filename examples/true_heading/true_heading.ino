@@ -0,0 +1,94 @@
+#include <Adafruit_MMC56x3.h>
+#include <Adafruit_MMC56x3_FieldCheck.h>
+#include <Adafruit_MMC56x3_WMM.h>
+
+/* Assign a unique ID to this sensor at the same time */
+Adafruit_MMC5603 mag = Adafruit_MMC5603(12345);
+
+Adafruit_MMC56x3_WMM wmm;
+Adafruit_MMC56x3_FieldCheck field_check;
+
+// Where and when we are: latitude, longitude (degrees), altitude (km)
+#define LATITUDE 40.71
+#define LONGITUDE -74.01
+#define ALTITUDE 0.0
+
+// Hard iron offsets from the calibration example, in uT. Without them the
+// board's own field shifts every reading and the field check fails.
+float mag_offsets[3] = {0, 0, 0};
+
+float declination;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit_MMC5603 True North Compass");
+  Serial.println("");
+
+  /* Initialise the sensor */
+  if (!mag.begin(MMC56X3_DEFAULT_ADDRESS, &Wire)) {  // I2C mode
+    /* There was a problem detecting the MMC5603 ... check your connections */
+    Serial.println("Ooops, no MMC5603 detected ... Check your wiring!");
+    while (1) delay(10);
+  }
+
+  float year = Adafruit_MMC56x3_WMM::decimalYear(2026, 1, 1);
+  mmc56x3_wmm_t field;
+
+  uint32_t start = micros();
+  if (!wmm.compute(LATITUDE, LONGITUDE, ALTITUDE, year, &field)) {
+    Serial.println("Date is outside the model's validity, results degrade");
+  }
+  uint32_t elapsed = micros() - start;
+
+  Serial.print("Model evaluated in "); Serial.print(elapsed);
+  Serial.println(" us");
+  Serial.print("Declination: "); Serial.print(field.declination);
+  Serial.println(" degrees");
+  Serial.print("Inclination: "); Serial.print(field.inclination);
+  Serial.println(" degrees");
+  Serial.print("Expected field: "); Serial.print(field.total);
+  Serial.println(" uT");
+  Serial.println("");
+
+  declination = field.declination;
+
+  // flag readings more than 10 uT away from what the model expects
+  field_check.setExpected(field.total);
+  field_check.setTolerance(10);
+}
+
+void loop(void)
+{
+  int32_t raw[3];
+  if (!mag.readRaw(raw))
+    return;
+
+  // hard iron correction, in raw counts
+  for (uint8_t i = 0; i < 3; i++) {
+    raw[i] -= lround(mag_offsets[i] / MMC56X3_LSB_UT);
+  }
+
+  if (field_check.check(raw) != MMC56X3_FIELD_OK) {
+    Serial.print("Disturbed field, magnitude ");
+    Serial.print(field_check.getMagnitude());
+    Serial.println(" uT");
+    delay(500);
+    return;
+  }
+
+  float magnetic = atan2(raw[1], raw[0]) * RAD_TO_DEG;
+  float heading = magnetic + declination;
+
+  // Normalize to 0-360
+  if (heading < 0)
+    heading += 360;
+  if (heading >= 360)
+    heading -= 360;
+
+  Serial.print("True Heading: ");
+  Serial.println(heading);
+  delay(500);
+}
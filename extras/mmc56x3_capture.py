@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""Reads MMC5603 capture files written by Adafruit_MMC56x3_Capture.
+
+The file is memory mapped and walked one record at a time, so recordings
+much larger than RAM can be converted or summarized. Files without a
+header (a raw Adafruit_MMC56x3_Stream dump) are read too, assuming no
+calibration.
+
+  mmc56x3_capture.py info   capture.bin
+  mmc56x3_capture.py stats  capture.bin
+  mmc56x3_capture.py csv    capture.bin [out.csv] [--calibrated]
+  mmc56x3_capture.py record capture.bin N
+"""
+
+import math
+import mmap
+import struct
+import sys
+
+MAGIC = b"MMC56CAP"
+HEADER = struct.Struct("<8sHHHHBBHIf3f9f4x")
+FRAME = struct.Struct("<BHIQB")
+FRAME_LEN = 16
+FRAME_SYNC = 0xA5
+LSB_UT = 0.00625
+
+
+def crc8(data):
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class Capture:
+    def __init__(self, path):
+        self._file = open(path, "rb")
+        self._map = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        self.config = {"data_rate": 0, "continuous": False, "sensors": 1,
+                       "start_time": 0, "lsb_ut": LSB_UT,
+                       "hard_iron": (0.0, 0.0, 0.0),
+                       "soft_iron": (1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0)}
+        self.offset = 0
+        if self._map[:8] == MAGIC:
+            f = HEADER.unpack_from(self._map, 0)
+            if f[1] != 1 or f[3] != FRAME_LEN:
+                raise ValueError("unsupported capture version or record size")
+            self.offset = f[2]
+            self.config.update(data_rate=f[4], continuous=bool(f[5]),
+                               sensors=f[6], start_time=f[8], lsb_ut=f[9],
+                               hard_iron=f[10:13], soft_iron=f[13:22])
+        self.count = (len(self._map) - self.offset) // FRAME_LEN
+
+    def record(self, n):
+        """Returns (seq, timestamp_us, sensor, x, y, z) in raw counts, or
+        None if record n is corrupt."""
+        pos = self.offset + n * FRAME_LEN
+        frame = self._map[pos:pos + FRAME_LEN]
+        sync, seq, ts, word, crc = FRAME.unpack(frame)
+        if sync != FRAME_SYNC or crc8(frame[1:15]) != crc:
+            return None
+        axes = [((word >> (20 * a)) & 0xFFFFF) - (1 << 19) for a in range(3)]
+        return (seq, ts, word >> 60, *axes)
+
+    def records(self):
+        for n in range(self.count):
+            yield n, self.record(n)
+
+    def calibrate(self, x, y, z):
+        c = self.config
+        lsb = c["lsb_ut"]
+        v = [x * lsb - c["hard_iron"][0], y * lsb - c["hard_iron"][1],
+             z * lsb - c["hard_iron"][2]]
+        m = c["soft_iron"]
+        return [m[3 * i] * v[0] + m[3 * i + 1] * v[1] + m[3 * i + 2] * v[2]
+                for i in range(3)]
+
+    def close(self):
+        self._map.close()
+        self._file.close()
+
+
+def cmd_info(cap, args):
+    for k, v in cap.config.items():
+        print("%-11s %s" % (k, v))
+    print("%-11s %d" % ("records", cap.count))
+
+
+def cmd_stats(cap, args):
+    # Welford running mean and variance, one pass, constant memory
+    n = [0] * 16
+    mean = [[0.0] * 3 for _ in range(16)]
+    m2 = [[0.0] * 3 for _ in range(16)]
+    lo = [[math.inf] * 3 for _ in range(16)]
+    hi = [[-math.inf] * 3 for _ in range(16)]
+    last_seq = None
+    lost = corrupt = 0
+    first_ts = last_ts = None
+    for _, r in cap.records():
+        if r is None:
+            corrupt += 1
+            continue
+        seq, ts, s = r[0], r[1], r[2]
+        if last_seq is not None:
+            lost += (seq - last_seq - 1) & 0xFFFF
+        last_seq = seq
+        first_ts = ts if first_ts is None else first_ts
+        last_ts = ts
+        n[s] += 1
+        for a, v in enumerate(cap.calibrate(*r[3:])):
+            d = v - mean[s][a]
+            mean[s][a] += d / n[s]
+            m2[s][a] += d * (v - mean[s][a])
+            lo[s][a] = min(lo[s][a], v)
+            hi[s][a] = max(hi[s][a], v)
+    print("records %d, corrupt %d, lost %d" % (cap.count, corrupt, lost))
+    if first_ts is not None:
+        span = ((last_ts - first_ts) & 0xFFFFFFFF) / 1e6
+        print("span %.3f s (timestamps wrap every 71.6 minutes)" % span)
+    for s in range(16):
+        if not n[s]:
+            continue
+        print("sensor %d: %d samples" % (s, n[s]))
+        for a, name in enumerate("xyz"):
+            sd = math.sqrt(m2[s][a] / (n[s] - 1)) if n[s] > 1 else 0.0
+            print("  %s uT  mean %10.4f  std %8.4f  min %10.4f  max %10.4f"
+                  % (name, mean[s][a], sd, lo[s][a], hi[s][a]))
+
+
+def cmd_csv(cap, args):
+    calibrated = "--calibrated" in args
+    args = [a for a in args if a != "--calibrated"]
+    out = open(args[0], "w") if args else sys.stdout
+    out.write("record,seq,timestamp_us,sensor,x_ut,y_ut,z_ut\n")
+    lsb = cap.config["lsb_ut"]
+    for n, r in cap.records():
+        if r is None:
+            continue
+        if calibrated:
+            v = cap.calibrate(*r[3:])
+        else:
+            v = [c * lsb for c in r[3:]]
+        out.write("%d,%d,%d,%d,%.5f,%.5f,%.5f\n" % (n, r[0], r[1], r[2], *v))
+    if out is not sys.stdout:
+        out.close()
+
+
+def cmd_record(cap, args):
+    n = int(args[0])
+    if not 0 <= n < cap.count:
+        sys.exit("record out of range, file has %d" % cap.count)
+    print(cap.record(n))
+
+
+def main():
+    commands = {"info": cmd_info, "stats": cmd_stats, "csv": cmd_csv,
+                "record": cmd_record}
+    if len(sys.argv) < 3 or sys.argv[1] not in commands:
+        sys.exit(__doc__)
+    cap = Capture(sys.argv[2])
+    try:
+        commands[sys.argv[1]](cap, sys.argv[3:])
+    finally:
+        cap.close()
+
+
+if __name__ == "__main__":
+    main()
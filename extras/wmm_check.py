@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+"""Checks the WMM coefficient table in Adafruit_MMC56x3_WMM.cpp against
+the files NOAA NCEI publishes with each World Magnetic Model release.
+
+Every {g, h, dg, dh} row is compared with WMM.COF, and the model epoch with
+MMC56X3_WMM_EPOCH. Given the release's test values table as well, the
+model is evaluated from the library's own table at each test point and
+the X, Y, Z, F, inclination and declination are compared with the
+published results. Exits with status 1 on any mismatch, so it can run
+in CI whenever the table is touched or a new epoch is dropped in.
+
+  wmm_check.py WMM.COF [WMM<epoch>_TestValues.txt]
+
+The test values table is whitespace separated, '#' starts a comment, and
+each row begins: date height_km lat lon X Y Z H F I D (nT and degrees).
+"""
+
+import math
+import os
+import re
+import sys
+
+LIBRARY = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+WMM_CPP = os.path.join(LIBRARY, "Adafruit_MMC56x3_WMM.cpp")
+WMM_H = os.path.join(LIBRARY, "Adafruit_MMC56x3_WMM.h")
+
+REF_RADIUS = 6371.2
+WGS84_A = 6378.137
+WGS84_E2 = 0.0066943799901413165
+
+COEFF_TOLERANCE = 0.001  # the files print a tenth of a nT
+FIELD_TOLERANCE = 0.5  # nT
+ANGLE_TOLERANCE = 0.01  # degrees
+
+
+def library_table():
+    """Returns the epoch, degree and coefficient rows the library uses."""
+    with open(WMM_H) as f:
+        header = f.read()
+    epoch = float(re.search(r"MMC56X3_WMM_EPOCH\s+([\d.]+)", header).group(1))
+    degree = int(re.search(r"MMC56X3_WMM_DEGREE\s+(\d+)", header).group(1))
+
+    with open(WMM_CPP) as f:
+        source = f.read()
+    body = re.search(r"wmm_coeffs\[\]\[4\][^{]*\{(.*?)\n\};", source, re.S)
+    number = r"\s*(-?[\d.]+)\s*"
+    rows = [
+        tuple(float(v) for v in m)
+        for m in re.findall(r"\{" + ",".join([number] * 4) + r"\}", body.group(1))
+    ]
+    return epoch, degree, rows
+
+
+def cof_table(path):
+    """Returns the epoch and the (n, m, g, h, dg, dh) rows of a WMM.COF."""
+    rows = []
+    epoch = None
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if not fields:
+                continue
+            if epoch is None:
+                epoch = float(fields[0])
+                continue
+            if fields[0].startswith("9999"):
+                break
+            n, m = int(fields[0]), int(fields[1])
+            rows.append((n, m) + tuple(float(v) for v in fields[2:6]))
+    return epoch, rows
+
+
+def evaluate(rows, epoch, degree, year, height, lat, lon):
+    """Evaluates the model in double precision the same way the library
+    does, returning X, Y, Z and F in nT and I and D in degrees."""
+    dt = year - epoch
+    lat_rad = math.radians(lat)
+    sin_lat, cos_lat = math.sin(lat_rad), math.cos(lat_rad)
+    rc = WGS84_A / math.sqrt(1 - WGS84_E2 * sin_lat * sin_lat)
+    p = (rc + height) * cos_lat
+    z = (rc * (1 - WGS84_E2) + height) * sin_lat
+    r = math.hypot(p, z)
+    ct, st = z / r, p / r
+    lon_rad = math.radians(lon)
+
+    # Schmidt semi-normalized Legendre functions and their derivatives
+    # with respect to colatitude
+    P = [[0.0] * (degree + 2) for _ in range(degree + 2)]
+    dP = [[0.0] * (degree + 2) for _ in range(degree + 2)]
+    P[0][0] = 1.0
+    for n in range(1, degree + 1):
+        for m in range(n + 1):
+            if m == n:
+                f = math.sqrt(1 - 1 / (2 * n)) if n > 1 else 1.0
+                P[n][m] = f * st * P[n - 1][m - 1]
+                dP[n][m] = f * (st * dP[n - 1][m - 1] + ct * P[n - 1][m - 1])
+            else:
+                a = math.sqrt(n * n - m * m)
+                b = math.sqrt((n - 1) ** 2 - m * m) if n - 1 >= m else 0.0
+                P[n][m] = ((2 * n - 1) * ct * P[n - 1][m] - b * P[n - 2][m]) / a
+                dP[n][m] = (
+                    (2 * n - 1) * (ct * dP[n - 1][m] - st * P[n - 1][m])
+                    - b * dP[n - 2][m]
+                ) / a
+
+    bx = by = bz = 0.0
+    idx = 0
+    for n in range(1, degree + 1):
+        ar = (REF_RADIUS / r) ** (n + 2)
+        for m in range(n + 1):
+            g0, h0, dg, dh = rows[idx]
+            idx += 1
+            g, h = g0 + dt * dg, h0 + dt * dh
+            c, s = math.cos(m * lon_rad), math.sin(m * lon_rad)
+            bx += ar * (g * c + h * s) * dP[n][m]
+            bz -= ar * (n + 1) * (g * c + h * s) * P[n][m]
+            if m and st:
+                by += ar * m * (g * s - h * c) * P[n][m] / st
+
+    sin_psi = ct * cos_lat - st * sin_lat
+    cos_psi = st * cos_lat + ct * sin_lat
+    north = bx * cos_psi - bz * sin_psi
+    down = bx * sin_psi + bz * cos_psi
+    horizontal = math.hypot(north, by)
+    return {
+        "X": north,
+        "Y": by,
+        "Z": down,
+        "F": math.hypot(horizontal, down),
+        "I": math.degrees(math.atan2(down, horizontal)),
+        "D": math.degrees(math.atan2(by, north)),
+    }
+
+
+def check_coefficients(cof_path):
+    epoch, degree, rows = library_table()
+    cof_epoch, cof_rows = cof_table(cof_path)
+    errors = 0
+    if epoch != cof_epoch:
+        print("epoch: library %.1f, WMM.COF %.1f" % (epoch, cof_epoch))
+        errors += 1
+    expected = [row for row in cof_rows if row[0] <= degree]
+    if len(rows) != len(expected):
+        print("rows: library %d, WMM.COF %d" % (len(rows), len(expected)))
+        errors += 1
+    for ours, (n, m, *theirs) in zip(rows, expected):
+        for name, a, b in zip(("g", "h", "dg", "dh"), ours, theirs):
+            if abs(a - b) > COEFF_TOLERANCE:
+                print("n=%d m=%d %s: library %.1f, WMM.COF %.1f" % (n, m, name, a, b))
+                errors += 1
+    print("%d coefficient rows checked, %d mismatches" % (len(expected), errors))
+    return errors
+
+
+def check_test_values(path):
+    epoch, degree, rows = library_table()
+    errors = points = 0
+    with open(path) as f:
+        for line in f:
+            line = line.split("#")[0].split()
+            if len(line) < 11:
+                continue
+            year, height, lat, lon = (float(v) for v in line[0:4])
+            published = dict(
+                zip(("X", "Y", "Z", "H", "F", "I", "D"), map(float, line[4:11]))
+            )
+            ours = evaluate(rows, epoch, degree, year, height, lat, lon)
+            points += 1
+            for name, value in ours.items():
+                tolerance = ANGLE_TOLERANCE if name in "ID" else FIELD_TOLERANCE
+                if abs(value - published[name]) > tolerance:
+                    print(
+                        "%.1f %.0f km %.1f %.1f %s: library %.2f, published %.2f"
+                        % (year, height, lat, lon, name, value, published[name])
+                    )
+                    errors += 1
+    print("%d test points checked, %d mismatches" % (points, errors))
+    return errors
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        print(__doc__)
+        return 2
+    errors = check_coefficients(argv[1])
+    if len(argv) == 3:
+        errors += check_test_values(argv[2])
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))